@@ -0,0 +1,184 @@
+/*
+ * safecore_active.c
+ *
+ * SafeCore Active Object Implementation
+ * This file implements the active object registry and the run-to-completion
+ * scheduler. Objects are registered by priority; bit n of the ready bitmap is
+ * set while the object of priority n has queued events, so the next object
+ * to run is found with a single count-trailing-zeros.
+ */
+#include "safecore_active.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if SAFECORE_ACTIVE_ENABLED == 1
+
+/* === Global Variables === */
+static sc_active_t *g_active[SAFECORE_MAX_ACTIVE_OBJECTS];
+static uint32_t g_active_ready;
+
+/**
+ * @brief Bus subscriber forwarding events to an active object
+ *
+ * @param e Delivered bus event
+ * @param ctx Active object
+ */
+static void active_on_bus_event(const sc_event_t *e, void *ctx) {
+    sc_sm_event_t sm_ev;
+    /* The size field counts the header too */
+    size_t n = (e->size > sizeof(sc_event_t)) ? ((size_t)e->size - sizeof(sc_event_t)) : 0U;
+
+    (void)memset(&sm_ev, 0, sizeof(sm_ev));
+    sm_ev.type = (sc_sm_event_type_t)((uint32_t)SC_EVENT_USER_START + e->id);
+    sm_ev.timestamp = e->timestamp;
+    if (n > sizeof(sm_ev.data.bytes)) {
+        n = sizeof(sm_ev.data.bytes);
+    }
+    (void)memcpy(sm_ev.data.bytes, (const uint8_t *)(const void *)e + sizeof(sc_event_t), n);
+
+    (void)sc_active_post((sc_active_t *)ctx, &sm_ev);
+}
+
+/**
+ * @brief Start an active object
+ *
+ * @param ao Active object
+ * @param prio Priority, 0 is the highest
+ * @param top Top-level state handler
+ * @param ctx Context pointer passed to state handlers
+ * @param name Optional name for debugging
+ * @param queue Event ring storage
+ * @param capacity Number of events in the ring storage
+ * @return int 0 on success, -1 on failure
+ */
+int sc_active_start(sc_active_t *ao, uint8_t prio, sc_sm_handler_t top, void *ctx,
+                    const char *name, sc_sm_event_t *queue, uint8_t capacity) {
+    sc_sm_event_t init_ev;
+
+    if ((ao == NULL) || (top == NULL) || (queue == NULL) || (capacity == 0U) ||
+        (prio >= SAFECORE_MAX_ACTIVE_OBJECTS) || (g_active[prio] != NULL)) {
+        return -1;
+    }
+
+    (void)memset(ao, 0, sizeof(*ao));
+    sc_sm_init(&ao->sm, top, ctx, name);
+    ao->queue = queue;
+    ao->capacity = capacity;
+    ao->prio = prio;
+    g_active[prio] = ao;
+
+    /* The initial transition runs from the scheduler like any other event */
+    (void)memset(&init_ev, 0, sizeof(init_ev));
+    init_ev.type = SC_EVENT_INIT;
+    init_ev.timestamp = safecore_get_tick_ms();
+    return sc_active_post(ao, &init_ev);
+}
+
+/**
+ * @brief Stop an active object
+ *
+ * @param ao Active object
+ */
+void sc_active_stop(sc_active_t *ao) {
+    if ((ao == NULL) || (ao->prio >= SAFECORE_MAX_ACTIVE_OBJECTS) || (g_active[ao->prio] != ao)) {
+        return;
+    }
+
+    g_active[ao->prio] = NULL;
+    g_active_ready &= ~(1UL << ao->prio);
+    ao->count = 0U;
+    ao->head = 0U;
+    ao->tail = 0U;
+}
+
+/**
+ * @brief Post an event to an active object
+ *
+ * @param ao Active object
+ * @param e Event to post
+ * @return int 0 on success, -1 on failure
+ */
+int sc_active_post(sc_active_t *ao, const sc_sm_event_t *e) {
+    if ((ao == NULL) || (e == NULL) || (ao->queue == NULL)) {
+        return -1;
+    }
+
+    /* A stopped object keeps its bus subscriptions: reject their events */
+    if ((ao->prio >= SAFECORE_MAX_ACTIVE_OBJECTS) || (g_active[ao->prio] != ao)) {
+        return -1;
+    }
+
+    if (ao->count >= ao->capacity) {
+        ao->dropped++;
+        return -1;
+    }
+
+    ao->queue[ao->head] = *e;
+    ao->head = (uint8_t)((ao->head + 1U) % ao->capacity);
+    ao->count++;
+    g_active_ready |= 1UL << ao->prio;
+    return 0;
+}
+
+/**
+ * @brief Forward bus events of an ID to an active object
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param ao Active object
+ * @param event_id Bus event ID
+ * @return int 0 on success, -1 on failure
+ */
+int sc_active_subscribe(sc_bus_t *bus, sc_active_t *ao, uint8_t event_id) {
+    if (ao == NULL) {
+        return -1;
+    }
+
+    return sc_bus_subscribe((bus != NULL) ? bus : sc_eventbus_default(), event_id,
+                            active_on_bus_event, ao);
+}
+
+/**
+ * @brief Dispatch the next event of the highest-priority ready object
+ *
+ * @return int 1 if an event was dispatched, 0 if no object is ready
+ */
+int sc_active_run_one(void) {
+    sc_active_t *ao;
+    sc_sm_event_t e;
+
+    if (g_active_ready == 0U) {
+        return 0;
+    }
+
+    ao = g_active[sc_prio_mask_first(g_active_ready)];
+
+    /* Take the event out first so the handler may post to its own queue */
+    e = ao->queue[ao->tail];
+    ao->tail = (uint8_t)((ao->tail + 1U) % ao->capacity);
+    ao->count--;
+    if (ao->count == 0U) {
+        g_active_ready &= ~(1UL << ao->prio);
+    }
+
+    sc_sm_dispatch(&ao->sm, &e);
+    return 1;
+}
+
+/**
+ * @brief Dispatch events until no active object is ready
+ *
+ * @param max_events Maximum number of events, 0 for no limit
+ * @return uint32_t Number of dispatched events
+ */
+uint32_t sc_active_run(uint32_t max_events) {
+    uint32_t n = 0U;
+
+    while (((max_events == 0U) || (n < max_events)) && (sc_active_run_one() != 0)) {
+        n++;
+    }
+
+    return n;
+}
+
+#endif /* SAFECORE_ACTIVE_ENABLED */
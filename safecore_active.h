@@ -0,0 +1,124 @@
+/*
+ * safecore_active.h
+ *
+ * SafeCore Active Object Module
+ * This header file defines active objects: state machines that own an event
+ * queue and a priority. A run-to-completion scheduler always dispatches the
+ * next event of the highest-priority ready object, so the latency of a
+ * critical state machine does not depend on the traffic of other components.
+ */
+
+#ifndef SAFECORE_ACTIVE_H
+#define SAFECORE_ACTIVE_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include "safecore_core.h"
+
+#if SAFECORE_ACTIVE_ENABLED == 1
+
+/**
+ * @defgroup SafeCore_ACTIVE SafeCore Active Object Module
+ * @brief State machines with event queues and a priority scheduler
+ * @{
+ */
+
+/**
+ * @brief Active object
+ *
+ * A state machine with its own ring of sc_sm_event_t entries. The queue
+ * storage is provided by the caller.
+ */
+typedef struct {
+    sc_state_machine_t sm;      /* State machine run by the object */
+    sc_sm_event_t *queue;       /* Event ring storage */
+    uint8_t capacity;           /* Ring capacity in events */
+    uint8_t head;               /* Next write position */
+    uint8_t tail;               /* Next read position */
+    uint8_t count;              /* Queued events */
+    uint8_t prio;               /* Priority, 0 is the highest */
+    uint32_t dropped;           /* Events rejected because the queue was full */
+} sc_active_t;
+
+/**
+ * @brief Start an active object
+ *
+ * Initializes the state machine, registers the object at its priority and
+ * queues an SC_EVENT_INIT event for it.
+ *
+ * @param ao Active object
+ * @param prio Priority below SAFECORE_MAX_ACTIVE_OBJECTS, 0 is the highest, one object per priority
+ * @param top Top-level state handler
+ * @param ctx Context pointer passed to state handlers
+ * @param name Optional name for debugging
+ * @param queue Event ring storage
+ * @param capacity Number of events in the ring storage
+ * @return int 0 on success, -1 on invalid parameters or if the priority is taken
+ */
+int sc_active_start(sc_active_t *ao, uint8_t prio, sc_sm_handler_t top, void *ctx,
+                    const char *name, sc_sm_event_t *queue, uint8_t capacity);
+
+/**
+ * @brief Stop an active object
+ *
+ * Unregisters the object and drops its queued events. Bus subscriptions
+ * made with sc_active_subscribe() cannot be removed and stay in place; their
+ * events are rejected by sc_active_post() until the object is started again.
+ *
+ * @param ao Active object
+ */
+void sc_active_stop(sc_active_t *ao);
+
+/**
+ * @brief Post an event to an active object
+ *
+ * The event is copied into the object's queue and dispatched later by
+ * sc_active_run(). Must be called from the context that runs the scheduler.
+ *
+ * @param ao Active object
+ * @param e Event to post
+ * @return int 0 on success, -1 on invalid parameters, if the object is stopped or if the queue is full
+ */
+int sc_active_post(sc_active_t *ao, const sc_sm_event_t *e);
+
+/**
+ * @brief Forward bus events of an ID to an active object
+ *
+ * Subscribes the object on the bus. Each delivered event is posted with type
+ * SC_EVENT_USER_START + event ID, the event timestamp, and up to 8 payload
+ * bytes following the sc_event_t header as data. The header's size field
+ * counts the whole event, so the payload is size - sizeof(sc_event_t)
+ * bytes; the rest of data is zero.
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param ao Active object
+ * @param event_id Bus event ID
+ * @return int 0 on success, -1 on failure
+ */
+int sc_active_subscribe(sc_bus_t *bus, sc_active_t *ao, uint8_t event_id);
+
+/**
+ * @brief Dispatch the next event of the highest-priority ready object
+ *
+ * Runs one event to completion.
+ *
+ * @return int 1 if an event was dispatched, 0 if no object is ready
+ */
+int sc_active_run_one(void);
+
+/**
+ * @brief Dispatch events until no active object is ready
+ *
+ * The priority is re-evaluated after every event, so an event posted to a
+ * higher-priority object during a dispatch is handled next.
+ *
+ * @param max_events Maximum number of events, 0 for no limit
+ * @return uint32_t Number of dispatched events
+ */
+uint32_t sc_active_run(uint32_t max_events);
+
+/** @} *//* End of SafeCore_ACTIVE group */
+
+#endif /* SAFECORE_ACTIVE_ENABLED */
+
+#endif /* SAFECORE_ACTIVE_H */
@@ -20,21 +20,56 @@
 #define SAFECORE_MAX_HSM_DEPTH               4   /* HSM maximum depth */
 #define SAFECORE_ENTRY_EXIT_ENABLED          1   /* State machine entry/exit events */
 #define SAFECORE_EVENT_QUEUE_SIZE            32  /* Basic queue size (must be power of 2) */
-#define SAFECORE_MAX_EVENT_SIZE              16  /* Maximum event size in bytes */
+#define SAFECORE_MAX_EVENT_SIZE              16  /* Maximum event size in bytes (at least 32 with EDF scheduling) */
+#define SAFECORE_QUEUE_VARLEN_ENABLED        0   /* Variable-length byte ring queues instead of fixed slots */
+#define SAFECORE_EVENT_QUEUE_BYTES           256 /* Byte ring size per priority level (variable-length mode) */
 #define SAFECORE_MAX_SUBSCRIBERS             8   /* Maximum number of subscribers */
 #define SAFECORE_MAX_EVENT_TYPES             16  /* Maximum number of event types */
 
 /* === Priority Queue Configuration === */
 #define SAFECORE_PRIORITY_ENABLED            1   /* Multiple priority queues */
-#define SAFECORE_EVENT_PRIORITIES            3   /* 0=emergency, 1=standard, 2=low priority */
+#define SAFECORE_EVENT_PRIORITIES            3   /* 0=emergency, 1=standard, 2=low priority (max 64) */
 #define SAFECORE_EMERGENCY_PRIORITY          0
 #define SAFECORE_STANDARD_PRIORITY           1
 #define SAFECORE_LOW_PRIORITY                2
 #define SAFECORE_MAX_EVENTS_PER_CYCLE        10  /* Maximum processed per priority per cycle */
+#define SAFECORE_SCHED_POLICY                0   /* 0=strict, 1=deficit round robin, 2=aging, 3=earliest deadline first */
+#define SAFECORE_SCHED_AGING_MS              50  /* Aging: unserved time that raises a level by one priority */
+#define SAFECORE_SCHED_PREEMPT               0   /* Return to higher levels that become ready between events */
+#define SAFECORE_EDF_QUEUE_SIZE              32  /* EDF: events held in the deadline queue */
+#define SAFECORE_EDF_DEFAULT_DEADLINE_MS     100 /* EDF: deadline of events that carry none */
+#define SAFECORE_LEVEL_SIZES_ENABLED         0   /* Per-priority queue sizes of the default bus */
+/* One X(queue_size, max_event_size) per priority level, highest priority first */
+#define SAFECORE_LEVEL_SIZES(X)              X(4, 16) X(32, 16) X(64, 16)
 
 /* === Event Filters Configuration === */
 #define SAFECORE_FILTERS_ENABLED             1   /* Event filters */
 #define SAFECORE_MAX_FILTER_RULES            8   /* Maximum number of filter rules */
+#define SAFECORE_FILTER_VM_ENABLED           0   /* Payload-inspecting filter programs (bytecode VM) */
+#define SAFECORE_FILTER_PROGRAMS             4   /* Filter program slots (max 8) */
+#define SAFECORE_FILTER_PROGRAM_LEN          32  /* Maximum instructions per filter program */
+#define SAFECORE_FILTER_RATE_ENABLED         0   /* Per-event-ID token-bucket rate limits (single producer only) */
+#define SAFECORE_FILTER_RATE_REPORT_ENABLED  0   /* Publish a summary event when an ID starts being limited */
+#define SAFECORE_FILTER_RATE_REPORT_ID       15  /* Event ID of the summary events */
+#define SAFECORE_FILTER_SWAP_ENABLED         0   /* Double-buffered filter tables swapped atomically (requires C11 atomics) */
+#define SAFECORE_FILTER_FILE_ENABLED         0   /* Reload filter rules from a file when it changes (POSIX stat) */
+
+/* === Event Pool Configuration === */
+#define SAFECORE_POOL_ENABLED                0   /* Reference-counted payload pools (requires C11 atomics) */
+#define SAFECORE_POOL_SMALL_SIZE             64  /* Small class block size in bytes */
+#define SAFECORE_POOL_SMALL_COUNT            16  /* Small class block count (max 32) */
+#define SAFECORE_POOL_MEDIUM_SIZE            256 /* Medium class block size in bytes */
+#define SAFECORE_POOL_MEDIUM_COUNT           8   /* Medium class block count (max 32) */
+#define SAFECORE_POOL_LARGE_SIZE             1024 /* Large class block size in bytes */
+#define SAFECORE_POOL_LARGE_COUNT            4   /* Large class block count (max 32) */
+
+/* === Active Object Configuration === */
+#define SAFECORE_ACTIVE_ENABLED              0   /* State machines with own event queues and a scheduler */
+#define SAFECORE_MAX_ACTIVE_OBJECTS          8   /* Maximum active objects, one per priority (max 32) */
+
+/* === Timer Configuration === */
+#define SAFECORE_TIMER_ENABLED               0   /* Timing wheel for delayed and periodic events */
+#define SAFECORE_MAX_TIMERS                  32  /* Maximum number of armed timers */
 
 /* === Diagnostics System Configuration === */
 #define SAFECORE_DIAGNOSTICS_ENABLED         0   /* Diagnostics system (automotive grade) */
@@ -62,8 +97,26 @@
 /* === Performance and Safety Configuration === */
 #define SAFECORE_QUEUE_OVERFLOW_POLICY       1   /* 0=drop newest, 1=drop oldest, 2=panic */
 #define SAFECORE_MAX_PROCESS_TIME_MS         10  /* Main loop processing timeout */
+#define SAFECORE_PROCESS_BUDGET_ENABLED      0   /* Time-budgeted processing (requires safecore_get_tick_us()) */
+#define SAFECORE_PROCESS_BATCH_ENABLED       1   /* Batched processing grouped by event ID (strict scheduling only) */
+#define SAFECORE_BATCH_MAX_EVENTS            32  /* Maximum events per level drained by one batch */
+#define SAFECORE_COALESCE_ENABLED            0   /* Last-value coalescing per event ID */
+#define SAFECORE_BACKPRESSURE_ENABLED        0   /* Queue watermarks, try-publish and congestion callback */
+#define SAFECORE_BACKPRESSURE_HIGH_PCT       75  /* Default high watermark, percent of a level's capacity */
+#define SAFECORE_BACKPRESSURE_LOW_PCT        25  /* Default low watermark, percent of a level's capacity */
+#define SAFECORE_SPILL_ENABLED               0   /* Overflow of low priority levels to a memory-mapped file (requires POSIX mmap) */
+#define SAFECORE_SPILL_MIN_LEVEL             SAFECORE_LOW_PRIORITY /* Levels from this one down spill */
+#define SAFECORE_HISTOGRAM_ENABLED           0   /* Queue wait, callback time and depth histograms (requires safecore_get_tick_us()) */
+#define SAFECORE_HIST_RANGE_BITS             20  /* Histogram values below 2^n get exact-scale buckets */
+#define SAFECORE_HIST_PER_ID_ENABLED         1   /* Also keep wait and callback histograms per event ID */
 #define SAFECORE_LOG_ENABLED                 1   /* Log output */
 
+/* === Concurrency Configuration === */
+#define SAFECORE_MPSC_ENABLED                0   /* Lock-free multi-producer queues (requires C11 atomics) */
+#define SAFECORE_WAIT_ENABLED                0   /* Blocking sc_eventbus_wait() (Linux futex, needs MPSC) */
+#define SAFECORE_PARALLEL_ENABLED            0   /* Worker-thread subscriber dispatch (requires POSIX threads) */
+#define SAFECORE_PARALLEL_WORKERS            3   /* Worker threads besides the processing thread */
+
 /* === MISRA-C 2012 Compliance === */
 #define SAFECORE_MISRA_COMPLIANT             1   /* MISRA-C 2012 compliance */
 
@@ -72,6 +125,12 @@
 #define SAFECORE_QUEUE_DROP_OLDEST           1
 #define SAFECORE_QUEUE_PANIC                 2
 
+/* === Scheduling Policy Macros === */
+#define SAFECORE_SCHED_STRICT                0
+#define SAFECORE_SCHED_DRR                   1
+#define SAFECORE_SCHED_AGING                 2
+#define SAFECORE_SCHED_EDF                   3
+
 /* === Safety Hook Macros === */
 #ifndef SAFECORE_ON_ERROR
 #define SAFECORE_ON_ERROR(msg) do { \
@@ -115,14 +174,113 @@ SC_STATIC_ASSERT(SAFECORE_MAX_EVENT_SIZE > 0,
 SC_STATIC_ASSERT(SAFECORE_MAX_SUBSCRIBERS > 0, 
                  safecore_max_subscribers_must_be_greater_than_zero);
 
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+/* Ensure the byte ring is record aligned and holds at least one maximum-size event */
+SC_STATIC_ASSERT((SAFECORE_EVENT_QUEUE_BYTES % 4) == 0, 
+                 safecore_event_queue_bytes_must_be_multiple_of_four);
+SC_STATIC_ASSERT(SAFECORE_EVENT_QUEUE_BYTES >= (SAFECORE_MAX_EVENT_SIZE + 4) && SAFECORE_EVENT_QUEUE_BYTES <= 0xFFFF, 
+                 safecore_event_queue_bytes_out_of_range);
+#endif
+
+#if SAFECORE_POOL_ENABLED == 1
+/* Ensure pool classes are ascending, 8-byte multiples and fit the free bitmaps */
+SC_STATIC_ASSERT((SAFECORE_POOL_SMALL_SIZE % 8) == 0 && (SAFECORE_POOL_MEDIUM_SIZE % 8) == 0 && 
+                 (SAFECORE_POOL_LARGE_SIZE % 8) == 0, 
+                 safecore_pool_sizes_must_be_multiple_of_eight);
+SC_STATIC_ASSERT(SAFECORE_POOL_SMALL_SIZE > 0 && SAFECORE_POOL_SMALL_SIZE < SAFECORE_POOL_MEDIUM_SIZE && 
+                 SAFECORE_POOL_MEDIUM_SIZE < SAFECORE_POOL_LARGE_SIZE, 
+                 safecore_pool_sizes_must_be_ascending);
+SC_STATIC_ASSERT(SAFECORE_POOL_SMALL_COUNT > 0 && SAFECORE_POOL_SMALL_COUNT <= 32 && 
+                 SAFECORE_POOL_MEDIUM_COUNT > 0 && SAFECORE_POOL_MEDIUM_COUNT <= 32 && 
+                 SAFECORE_POOL_LARGE_COUNT > 0 && SAFECORE_POOL_LARGE_COUNT <= 32, 
+                 safecore_pool_counts_out_of_range);
+#endif
+
+#if SAFECORE_ACTIVE_ENABLED == 1
+/* Ensure active object priorities fit the ready bitmap */
+SC_STATIC_ASSERT(SAFECORE_MAX_ACTIVE_OBJECTS > 0 && SAFECORE_MAX_ACTIVE_OBJECTS <= 32, 
+                 safecore_max_active_objects_must_be_between_1_and_32);
+#endif
+
+#if SAFECORE_TIMER_ENABLED == 1
+/* Ensure timer indices fit the wheel list index type */
+SC_STATIC_ASSERT(SAFECORE_MAX_TIMERS > 0 && SAFECORE_MAX_TIMERS < 0xFFFF, 
+                 safecore_max_timers_out_of_range);
+#endif
+
+#if SAFECORE_PARALLEL_ENABLED == 1
+/* Ensure at least one worker thread and that lanes fit the domain type */
+SC_STATIC_ASSERT(SAFECORE_PARALLEL_WORKERS > 0 && SAFECORE_PARALLEL_WORKERS < 255, 
+                 safecore_parallel_workers_out_of_range);
+#endif
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/* Ensure the default watermarks leave a hysteresis band */
+SC_STATIC_ASSERT(SAFECORE_BACKPRESSURE_LOW_PCT >= 0 && SAFECORE_BACKPRESSURE_LOW_PCT < SAFECORE_BACKPRESSURE_HIGH_PCT && 
+                 SAFECORE_BACKPRESSURE_HIGH_PCT <= 100, 
+                 safecore_backpressure_watermarks_out_of_range);
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+/* Ensure at least one priority level spills */
+SC_STATIC_ASSERT(SAFECORE_SPILL_MIN_LEVEL >= 0 && SAFECORE_SPILL_MIN_LEVEL < SAFECORE_EVENT_PRIORITIES, 
+                 safecore_spill_min_level_out_of_range);
+#endif
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+/* Ensure the histogram range covers more than the linear buckets and fits 32-bit values */
+SC_STATIC_ASSERT(SAFECORE_HIST_RANGE_BITS >= 3 && SAFECORE_HIST_RANGE_BITS <= 32, 
+                 safecore_hist_range_bits_out_of_range);
+#endif
+
+/* Ensure batch size is not zero and fits the queue depth type */
+SC_STATIC_ASSERT(SAFECORE_BATCH_MAX_EVENTS > 0 && SAFECORE_BATCH_MAX_EVENTS <= 0xFFFF, 
+                 safecore_batch_max_events_out_of_range);
+
+/* Ensure subscriber indices fit the dispatch chain index type */
+SC_STATIC_ASSERT(SAFECORE_MAX_SUBSCRIBERS < 0xFFFF, 
+                 safecore_max_subscribers_must_be_below_65535);
+
+/* Ensure event IDs fit the uint8_t event ID field */
+SC_STATIC_ASSERT(SAFECORE_MAX_EVENT_TYPES <= 256, 
+                 safecore_max_event_types_must_fit_event_id);
+
 /* Ensure maximum event types count is not zero */
 SC_STATIC_ASSERT(SAFECORE_MAX_EVENT_TYPES > 0, 
                  safecore_max_event_types_must_be_greater_than_zero);
 
 /* When priority is enabled, ensure priority count is within valid range */
 #if SAFECORE_PRIORITY_ENABLED == 1
-SC_STATIC_ASSERT(SAFECORE_EVENT_PRIORITIES > 0 && SAFECORE_EVENT_PRIORITIES <= 8, 
-                 safecore_event_priorities_must_be_between_1_and_8);
+SC_STATIC_ASSERT(SAFECORE_EVENT_PRIORITIES > 0 && SAFECORE_EVENT_PRIORITIES <= 64, 
+                 safecore_event_priorities_must_be_between_1_and_64);
+#endif
+
+/* When priority is enabled, ensure the scheduling policy is known */
+#if SAFECORE_PRIORITY_ENABLED == 1
+SC_STATIC_ASSERT(SAFECORE_SCHED_POLICY >= 0 && SAFECORE_SCHED_POLICY <= 3, 
+                 safecore_sched_policy_must_be_strict_drr_aging_or_edf);
+SC_STATIC_ASSERT(SAFECORE_SCHED_AGING_MS > 0, 
+                 safecore_sched_aging_ms_must_be_greater_than_zero);
+#endif
+
+/* With EDF scheduling, ensure the deadline queue fits its slot index type */
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+SC_STATIC_ASSERT(SAFECORE_EDF_QUEUE_SIZE > 0 && SAFECORE_EDF_QUEUE_SIZE < 0xFFFF, 
+                 safecore_edf_queue_size_out_of_range);
+SC_STATIC_ASSERT(SAFECORE_EDF_DEFAULT_DEADLINE_MS > 0 && SAFECORE_EDF_DEFAULT_DEADLINE_MS <= 0xFFFF, 
+                 safecore_edf_default_deadline_ms_out_of_range);
+#endif
+
+/* With per-priority sizes, ensure the table has one fitting entry per level */
+#if SAFECORE_LEVEL_SIZES_ENABLED == 1
+#define SC_LEVEL_COUNT(queue_size, event_size)  + 1
+#define SC_LEVEL_FITS(queue_size, event_size)   && ((event_size) > 0) && ((event_size) <= SAFECORE_MAX_EVENT_SIZE)
+SC_STATIC_ASSERT((0 SAFECORE_LEVEL_SIZES(SC_LEVEL_COUNT)) == SAFECORE_TOTAL_QUEUES, 
+                 safecore_level_sizes_must_have_one_entry_per_priority);
+SC_STATIC_ASSERT((1 SAFECORE_LEVEL_SIZES(SC_LEVEL_FITS)), 
+                 safecore_level_event_sizes_must_not_exceed_max_event_size);
+#undef SC_LEVEL_COUNT
+#undef SC_LEVEL_FITS
 #endif
 
 /* When filters are enabled, ensure maximum filter rules count is not zero */
@@ -131,4 +289,18 @@ SC_STATIC_ASSERT(SAFECORE_MAX_FILTER_RULES > 0,
                  safecore_max_filter_rules_must_be_greater_than_zero);
 #endif
 
+/* With filter programs, ensure the slots fit the per-ID program mask */
+#if SAFECORE_FILTER_VM_ENABLED == 1
+SC_STATIC_ASSERT(SAFECORE_FILTER_PROGRAMS > 0 && SAFECORE_FILTER_PROGRAMS <= 8, 
+                 safecore_filter_programs_out_of_range);
+SC_STATIC_ASSERT(SAFECORE_FILTER_PROGRAM_LEN > 0 && SAFECORE_FILTER_PROGRAM_LEN <= 255, 
+                 safecore_filter_program_len_out_of_range);
+#endif
+
+/* With rate limit reports, ensure the summary event ID is valid */
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+SC_STATIC_ASSERT(SAFECORE_FILTER_RATE_REPORT_ID < SAFECORE_MAX_EVENT_TYPES, 
+                 safecore_filter_rate_report_id_out_of_range);
+#endif
+
 #endif /* SAFECORE_CONFIG_H */
\ No newline at end of file
@@ -5,11 +5,26 @@
  * This file implements the core functionality of the SafeCore framework,
  * including state machine processing and the event bus system for component communication.
  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* syscall() for the futex wait */
+#endif
 #include "safecore_core.h"
 #include "safecore_port.h"
 #include "safecore_config.h"
 #include "safecore_module_config.h"
+#include "safecore_priority.h"
+#include "safecore_filters.h"
+#include "safecore_pool.h"
+#include "safecore_timer.h"
+#include "safecore_parallel.h"
 #include <string.h>
+#if SAFECORE_WAIT_ENABLED == 1
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
 
 /* === State Machine Implementation === */
 
@@ -170,211 +185,2074 @@ void sc_sm_send_exit(sc_state_machine_t *sm, void *ctx) {
 /* === Basic Event Bus Implementation === */
 #if SAFECORE_BASIC_ENABLED == 1
 
+/* === Default Instance Configuration === */
+#if SAFECORE_PRIORITY_ENABLED == 1
+#define SC_DEFAULT_BUS_PRIORITIES       SAFECORE_EVENT_PRIORITIES
+#else
+#define SC_DEFAULT_BUS_PRIORITIES       1U
+#endif
+
+#if SAFECORE_FILTERS_ENABLED == 1
+#define SC_DEFAULT_BUS_FILTER_RULES     SAFECORE_MAX_FILTER_RULES
+#else
+#define SC_DEFAULT_BUS_FILTER_RULES     0U
+#endif
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+#define SC_DEFAULT_BUS_QUEUE_SIZE       SAFECORE_EVENT_QUEUE_BYTES
+#else
+#define SC_DEFAULT_BUS_QUEUE_SIZE       SAFECORE_EVENT_QUEUE_SIZE
+#endif
+
+#if SAFECORE_LEVEL_SIZES_ENABLED == 1
+#define SC_DEFAULT_LEVEL_BYTES(queue_size, event_size)  + SC_BUS_LEVEL_BYTES(queue_size, event_size)
+#define SC_DEFAULT_LEVEL_ENTRY(queue_size, event_size)  { (queue_size), (event_size) },
+#define SC_DEFAULT_BUS_STORAGE_SIZE \
+    (SC_BUS_BASE_BYTES(SAFECORE_MAX_SUBSCRIBERS, SC_DEFAULT_BUS_PRIORITIES, \
+                       SC_DEFAULT_BUS_FILTER_RULES) \
+     SAFECORE_LEVEL_SIZES(SC_DEFAULT_LEVEL_BYTES))
+#else
+#define SC_DEFAULT_BUS_STORAGE_SIZE \
+    SC_BUS_STORAGE_SIZE(SAFECORE_MAX_SUBSCRIBERS, SC_DEFAULT_BUS_QUEUE_SIZE, \
+                        SAFECORE_MAX_EVENT_SIZE, SC_DEFAULT_BUS_PRIORITIES, \
+                        SC_DEFAULT_BUS_FILTER_RULES)
+#endif
+
 /* === Global Variables === */
-static subscriber_entry_t g_subscribers[SAFECORE_MAX_SUBSCRIBERS]; /* Array of subscribers */
-static uint8_t g_subscriber_count = 0; /* Current number of subscribers */
+#if SAFECORE_LEVEL_SIZES_ENABLED == 1
+static const sc_bus_level_config_t g_default_bus_levels[SC_DEFAULT_BUS_PRIORITIES] = {
+    SAFECORE_LEVEL_SIZES(SC_DEFAULT_LEVEL_ENTRY)
+};
+#endif
+static const sc_bus_config_t g_default_bus_cfg = {
+    SAFECORE_MAX_SUBSCRIBERS,
+    SC_DEFAULT_BUS_QUEUE_SIZE,
+    SAFECORE_MAX_EVENT_SIZE,
+    SC_DEFAULT_BUS_PRIORITIES,
+    SC_DEFAULT_BUS_FILTER_RULES,
+#if SAFECORE_LEVEL_SIZES_ENABLED == 1
+    g_default_bus_levels
+#else
+    NULL
+#endif
+};
+static uint64_t g_default_bus_storage[(SC_DEFAULT_BUS_STORAGE_SIZE + 7U) / 8U]; /* Default instance memory */
+static sc_bus_t g_default_bus; /* Default instance used by the sc_eventbus_* API */
+
+/**
+ * @brief Take an aligned region from bus storage
+ * 
+ * @param cursor Current position in the storage, advanced past the region
+ * @param end End of the storage
+ * @param size Region size in bytes
+ * @return uint8_t* Start of the region, or NULL if the storage is exhausted
+ */
+static uint8_t* bus_carve(uintptr_t *cursor, uintptr_t end, size_t size) {
+    uintptr_t start = (*cursor + (SC_BUS_ALIGN - 1U)) & ~((uintptr_t)SC_BUS_ALIGN - 1U);
+    uint8_t *region = NULL;
+
+    if ((start <= end) && (SC_BUS_ALIGN_UP(size) <= (size_t)(end - start))) {
+        region = (uint8_t *)start;
+        *cursor = start + SC_BUS_ALIGN_UP(size);
+    }
 
-/* === Single Queue Implementation (When Priority is Disabled) === */
-#if SAFECORE_PRIORITY_ENABLED != 1
-static uint8_t g_event_queue[SAFECORE_EVENT_QUEUE_SIZE][SAFECORE_MAX_EVENT_SIZE]; /* Event queue storage */
-static volatile uint8_t g_head = 0; /* Queue head index */
-static volatile uint8_t g_tail = 0; /* Queue tail index */
+    return region;
+}
 
+#if (SAFECORE_POOL_ENABLED == 1) || (SAFECORE_COALESCE_ENABLED == 1)
 /**
- * @brief Check if the event queue is full
+ * @brief Queue hook of an instance
  * 
- * This function determines if the event queue is full by checking if the
- * next head position would collide with the tail position.
+ * Forgets the pending slot of a coalescing event once it is taken or freed,
+ * and drops the pool reference of a freed handle event.
  * 
- * @return uint8_t 1 if the queue is full, 0 otherwise
+ * @param ctx Event bus instance
+ * @param event Event taken or freed
+ * @param size Size of the event in bytes
+ * @param reason SC_QUEUE_HOOK_TAKEN or SC_QUEUE_HOOK_FREED
  */
-SAFECORE_INLINE uint8_t queue_full(void) {
-    /* Using unsigned suffix to avoid integer overflow */
-    return (uint8_t)((g_head + 1U) & (SAFECORE_EVENT_QUEUE_SIZE - 1U)) == g_tail;
+static void bus_queue_hook(void *ctx, const uint8_t *event, size_t size, uint8_t reason) {
+    const sc_event_t *e = (const sc_event_t *)(const void *)event;
+
+    if (size < sizeof(sc_event_t)) {
+        return;
+    }
+
+#if SAFECORE_COALESCE_ENABLED == 1
+    sc_bus_t *bus = (sc_bus_t *)ctx;
+    if ((e->id < SAFECORE_MAX_EVENT_TYPES) && (bus->pending[e->id].slot == event)) {
+        /* No longer overwritable */
+        bus->pending[e->id].slot = NULL;
+    }
+#else
+    (void)ctx;
+#endif
+
+#if SAFECORE_POOL_ENABLED == 1
+    if ((reason == SC_QUEUE_HOOK_FREED) && (size >= sizeof(sc_pool_event_t))) {
+        sc_pool_release_event(e);
+    }
+#else
+    (void)reason;
+#endif
 }
+#endif
 
+#if SAFECORE_HISTOGRAM_ENABLED == 1
 /**
- * @brief Check if the event queue is empty
+ * @brief Stamp a queued event with its enqueue time
  * 
- * This function determines if the event queue is empty by checking if
- * head and tail positions are the same.
- * 
- * @return uint8_t 1 if the queue is empty, 0 otherwise
+ * @param event Event in its queue slot
+ * @param size Size of the event in bytes
  */
-SAFECORE_INLINE uint8_t queue_empty(void) {
-    return g_head == g_tail;
+static void bus_stamp(uint8_t *event, size_t size) {
+    if (size >= sizeof(sc_event_t)) {
+        ((sc_event_t *)(void *)event)->timestampMicro = safecore_get_tick_us();
+    }
 }
+#endif
 
+#if SAFECORE_COALESCE_ENABLED == 1
 /**
- * @brief Push an event to the queue
+ * @brief Overwrite the pending event of a coalescing ID in place
  * 
- * This function adds an event to the end of the queue, handling overflow
- * according to the configured policy.
+ * @param bus Event bus instance
+ * @param level Priority level the new event goes to
+ * @param event_data New event data
+ * @param size Size of the new event in bytes
+ * @return int 1 if the pending event was overwritten, 0 if the event must be queued
+ */
+static int bus_coalesce(sc_bus_t *bus, uint8_t level, const uint8_t *event_data, size_t size) {
+    const sc_event_t *e = (const sc_event_t *)(const void *)event_data;
+    sc_bus_pending_t *p;
+
+    if ((size < sizeof(sc_event_t)) || (e->id >= SAFECORE_MAX_EVENT_TYPES)) {
+        return 0;
+    }
+
+    p = &bus->pending[e->id];
+    if ((p->enabled == 0U) || (p->slot == NULL) || (p->level != level) || (p->size != size)) {
+        return 0;
+    }
+
+    (void)memcpy(p->slot, event_data, size);
+    ((sc_event_t *)(void *)p->slot)->flags = 0U;
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+    bus_stamp(p->slot, size);
+#endif
+    return 1;
+}
+
+/**
+ * @brief Remember a newly queued event of a coalescing ID
  * 
- * @param data Pointer to the event data
- * @param size Size of the event data in bytes
- * @return int 0 on success, -1 on failure
+ * @param bus Event bus instance
+ * @param level Priority level of the event
+ * @param slot Queued event
+ * @param size Size of the event in bytes
  */
-static inline int queue_push(const uint8_t *data, size_t size) {
-    int result = -1;
-    
-    /* Validate input parameters */
-    if ((data != NULL) && (size > 0U) && (size <= SAFECORE_MAX_EVENT_SIZE)) {
-        /* Handle queue overflow according to configured policy */
-        if (queue_full()) {
-#if SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST
-            /* Drop oldest event by moving tail forward */
-            g_tail = (uint8_t)((g_tail + 1U) % SAFECORE_EVENT_QUEUE_SIZE);
-#elif SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_PANIC
-            SAFECORE_ON_ERROR("Event queue overflow - PANIC");
-            /* Safety shutdown - infinite loop */
-            for (;;) {
-                /* Safety shutdown */
-            }
+static void bus_coalesce_track(sc_bus_t *bus, uint8_t level, uint8_t *slot, size_t size) {
+    const sc_event_t *e = (const sc_event_t *)(const void *)slot;
+
+    if ((size >= sizeof(sc_event_t)) && (e->id < SAFECORE_MAX_EVENT_TYPES) &&
+        (bus->pending[e->id].enabled != 0U)) {
+        bus->pending[e->id].slot = slot;
+        bus->pending[e->id].size = (uint16_t)size;
+        bus->pending[e->id].level = level;
+    }
+}
 #endif
-        }
-        
-        /* Copy event data to queue */
-        (void)memcpy(g_event_queue[g_head], data, size);
-        /* Update head pointer with wrap-around */
-        g_head = (uint8_t)((g_head + 1U) % SAFECORE_EVENT_QUEUE_SIZE);
-        result = 0;
+
+/**
+ * @brief Get the queue sizes of a priority level
+ * 
+ * @param cfg Instance configuration
+ * @param level Priority level (must be below cfg->priorities)
+ * @return sc_bus_level_config_t Queue size and maximum event size of the level
+ */
+static sc_bus_level_config_t bus_level_config(const sc_bus_config_t *cfg, uint8_t level) {
+    sc_bus_level_config_t lc;
+
+    if (cfg->levels != NULL) {
+        lc = cfg->levels[level];
+    } else {
+        lc.queue_size = cfg->queue_size;
+        lc.max_event_size = cfg->max_event_size;
     }
-    
-    return result;
+
+    return lc;
 }
 
 /**
- * @brief Pop an event from the queue
+ * @brief Check the queue sizes of a priority level
  * 
- * This function retrieves and removes an event from the front of the queue.
+ * @param lc Queue sizes of the level
+ * @return int 1 if valid, 0 otherwise
+ */
+static int bus_level_valid(const sc_bus_level_config_t *lc) {
+    if (lc->max_event_size == 0U) {
+        return 0;
+    }
+
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+    /* Every event must fit a deadline queue slot */
+    if (lc->max_event_size > SAFECORE_MAX_EVENT_SIZE) {
+        return 0;
+    }
+#endif
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+    /* Ring must be record aligned and hold one maximum-size event */
+    return (((lc->queue_size % SC_QUEUE_RECORD_ALIGN) == 0U) &&
+            (lc->queue_size >= SC_QUEUE_RECORD_BYTES(lc->max_event_size))) ? 1 : 0;
+#else
+    return ((lc->queue_size >= 2U) && ((lc->queue_size & (lc->queue_size - 1U)) == 0U)) ? 1 : 0;
+#endif
+}
+
+/**
+ * @brief Get the storage size required by an event bus instance
  * 
- * @return const uint8_t* Pointer to the event data, or NULL if queue is empty
+ * @param cfg Instance configuration
+ * @return size_t Number of bytes sc_bus_init() needs, 0 on invalid parameters
  */
-SAFECORE_INLINE const uint8_t* queue_pop(void) {
-    if (queue_empty()) return NULL;
-    const uint8_t *e = g_event_queue[g_tail];
-    g_tail = (g_tail + 1) % SAFECORE_EVENT_QUEUE_SIZE;
-    return e;
+size_t sc_bus_storage_size(const sc_bus_config_t *cfg) {
+    size_t size;
+    uint8_t i;
+
+    if (cfg == NULL) {
+        return 0U;
+    }
+
+    size = SC_BUS_BASE_BYTES(cfg->max_subscribers, cfg->priorities, cfg->max_filter_rules);
+    for (i = 0U; i < cfg->priorities; i++) {
+        sc_bus_level_config_t lc = bus_level_config(cfg, i);
+        size += SC_BUS_LEVEL_BYTES(lc.queue_size, lc.max_event_size);
+    }
+
+    return size;
 }
-#endif /* SAFECORE_PRIORITY_ENABLED != 1 */
 
 /**
- * @brief Initialize the event bus
+ * @brief Lay out and initialize the queue of one priority level
  * 
- * This function initializes the event bus system, resetting subscribers
- * and queue pointers.
+ * @param q Queue to initialize
+ * @param lc Queue sizes of the level
+ * @param cursor Current position in the storage, advanced past the queue
+ * @param end End of the storage
+ * @return int 0 on success, -1 if the storage is exhausted
  */
-void sc_eventbus_init(void) {
-    /* Clear subscriber list */
-    (void)memset(g_subscribers, 0, sizeof(g_subscribers));
-    g_subscriber_count = 0;
-    
-#if SAFECORE_PRIORITY_ENABLED != 1
-    /* Reset queue pointers */
-    g_head = g_tail = 0;
+static int bus_level_init(sc_queue_t *q, const sc_bus_level_config_t *lc, uintptr_t *cursor,
+                          uintptr_t end) {
+    size_t slots = lc->queue_size; /* Ring bytes in variable-length mode */
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+    uint8_t *ring_mem = bus_carve(cursor, end, slots);
+    if (ring_mem == NULL) {
+        return -1;
+    }
+    return sc_queue_init(q, ring_mem, lc->queue_size, lc->max_event_size);
+#else
+    uint8_t *slot_mem = bus_carve(cursor, end, slots * lc->max_event_size);
+    uint16_t *size_mem = (uint16_t *)bus_carve(cursor, end, slots * sizeof(uint16_t));
+#if SAFECORE_MPSC_ENABLED == 1
+    sc_queue_seq_t *seq_mem = (sc_queue_seq_t *)bus_carve(cursor, end, slots * sizeof(sc_queue_seq_t));
+    if ((slot_mem == NULL) || (size_mem == NULL) || (seq_mem == NULL)) {
+        return -1;
+    }
+    return sc_queue_init(q, slot_mem, size_mem, seq_mem, lc->queue_size, lc->max_event_size);
+#else
+    if ((slot_mem == NULL) || (size_mem == NULL)) {
+        return -1;
+    }
+    return sc_queue_init(q, slot_mem, size_mem, lc->queue_size, lc->max_event_size);
+#endif
+#endif
+}
+
+/**
+ * @brief Initialize an event bus instance
+ * 
+ * This function validates the configuration, lays out the subscriber table,
+ * queues and filter rules in the caller-provided memory and resets them.
+ * The queues of all levels share one contiguous region, each level sized
+ * by its own queue size and maximum event size.
+ * 
+ * @param bus Instance to initialize
+ * @param cfg Instance configuration
+ * @param storage Caller-provided memory
+ * @param storage_size Size of the provided memory in bytes
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_init(sc_bus_t *bus, const sc_bus_config_t *cfg, void *storage, size_t storage_size) {
+    uint8_t i;
+
+    /* Validate input parameters */
+    if ((bus == NULL) || (cfg == NULL) || (storage == NULL) ||
+        (cfg->max_subscribers == 0U) || (cfg->max_subscribers >= SC_SUBSCRIBER_NONE) ||
+        (cfg->priorities == 0U) || (storage_size < sc_bus_storage_size(cfg))) {
+        return -1;
+    }
+
+    for (i = 0U; i < cfg->priorities; i++) {
+        sc_bus_level_config_t lc = bus_level_config(cfg, i);
+        if (bus_level_valid(&lc) == 0) {
+            return -1;
+        }
+    }
+
+#if SAFECORE_PRIORITY_ENABLED == 1
+    if (cfg->priorities > SAFECORE_EVENT_PRIORITIES) {
+        return -1;
+    }
+#else
+    if (cfg->priorities != 1U) {
+        return -1; /* Events carry no priority field */
+    }
+#endif
+
+    uintptr_t cursor = (uintptr_t)storage;
+    uintptr_t end = cursor + storage_size;
+
+    (void)memset(bus, 0, sizeof(*bus));
+    (void)memset(storage, 0, storage_size);
+
+    /* Lay out the instance storage */
+    bus->subscribers = (subscriber_entry_t *)bus_carve(&cursor, end,
+                            (size_t)cfg->max_subscribers * sizeof(subscriber_entry_t));
+    bus->queues = (sc_queue_t *)bus_carve(&cursor, end, (size_t)cfg->priorities * sizeof(sc_queue_t));
+    if ((bus->subscribers == NULL) || (bus->queues == NULL)) {
+        return -1;
+    }
+
+    bus->max_subscribers = cfg->max_subscribers;
+    bus->priorities = cfg->priorities;
+    bus->peek_level = SC_BUS_NO_LEVEL;
+
+    /* Empty all dispatch chains */
+    for (i = 0U; i < SAFECORE_MAX_EVENT_TYPES; i++) {
+        bus->dispatch_heads[i] = SC_SUBSCRIBER_NONE;
+        bus->dispatch_tails[i] = SC_SUBSCRIBER_NONE;
+    }
+
+    /* Set up one queue per priority level, back to back */
+    for (i = 0U; i < cfg->priorities; i++) {
+        sc_bus_level_config_t lc = bus_level_config(cfg, i);
+        if (bus_level_init(&bus->queues[i], &lc, &cursor, end) != 0) {
+            return -1;
+        }
+#if (SAFECORE_POOL_ENABLED == 1) || (SAFECORE_COALESCE_ENABLED == 1)
+        sc_queue_set_hook(&bus->queues[i], bus_queue_hook, bus);
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+        /* Default watermarks: percentages of the level's capacity */
+        uint32_t cap = sc_queue_capacity(&bus->queues[i]);
+        uint32_t high = (cap * SAFECORE_BACKPRESSURE_HIGH_PCT) / 100U;
+        uint32_t low = (cap * SAFECORE_BACKPRESSURE_LOW_PCT) / 100U;
+        if (high == 0U) {
+            high = 1U;
+        }
+        if (low >= high) {
+            low = high - 1U;
+        }
+        bus->bp.high[i] = (uint16_t)high;
+        bus->bp.low[i] = (uint16_t)low;
+#endif
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR)
+        /* Default quantum: a strict cycle's worth of maximum-size events */
+        uint32_t weight = (uint32_t)lc.max_event_size * SAFECORE_MAX_EVENTS_PER_CYCLE;
+        bus->sched.weight[i] = (weight > 0xFFFFU) ? 0xFFFFU : (uint16_t)weight;
+#endif
+    }
+
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+    sc_edf_init(&bus->sched.edf);
 #endif
 
-#if SAFECORE_FILTERS_ENABLED == 1U
+#if SAFECORE_FILTERS_ENABLED == 1
     /* Initialize event filters if enabled */
-    sc_filters_init();
-    #endif
+    sc_filter_rule_t *rule_mem = NULL;
+    if (cfg->max_filter_rules > 0U) {
+        rule_mem = (sc_filter_rule_t *)bus_carve(&cursor, end,
+                        (size_t)cfg->max_filter_rules * sizeof(sc_filter_rule_t));
+        if (rule_mem == NULL) {
+            return -1;
+        }
+    }
+    bus->filters.rules = rule_mem;
+    bus->filters.max_rules = cfg->max_filter_rules;
+    sc_bus_filters_init(bus);
+#endif
+
+    return 0;
 }
 
 /**
- * @brief Subscribe to an event
+ * @brief Subscribe to an event on an instance
  * 
  * This function registers a callback to receive notifications when
- * events with the specified ID are published.
+ * events with the specified ID are published on the instance.
  * 
+ * @param bus Event bus instance
  * @param event_id ID of the event to subscribe to
  * @param callback Function to call when the event is published
  * @param ctx Context pointer to pass to the callback
  * @return int 0 on success, -1 on failure
  */
-int sc_eventbus_subscribe(uint8_t event_id, sc_subscriber_fn_t callback, void *ctx) {
+int sc_bus_subscribe(sc_bus_t *bus, uint8_t event_id, sc_subscriber_fn_t callback, void *ctx) {
     /* Validate input parameters and check for available slots */
-    if (event_id >= SAFECORE_MAX_EVENT_TYPES || !callback || 
-        g_subscriber_count >= SAFECORE_MAX_SUBSCRIBERS) {
+    if (bus == NULL || event_id >= SAFECORE_MAX_EVENT_TYPES || !callback || 
+        bus->subscriber_count >= bus->max_subscribers) {
         return -1;
     }
     
     /* Add subscriber to the list */
-    g_subscribers[g_subscriber_count++] = (subscriber_entry_t){event_id, callback, ctx};
+    sc_subscriber_index_t idx = (sc_subscriber_index_t)bus->subscriber_count;
+    bus->subscribers[idx] = (subscriber_entry_t){event_id, callback, ctx, SC_SUBSCRIBER_NONE, 0U};
+    bus->subscriber_count++;
+
+    /* Append to the event type's dispatch chain to keep subscription order */
+    if (bus->dispatch_tails[event_id] == SC_SUBSCRIBER_NONE) {
+        bus->dispatch_heads[event_id] = idx;
+    } else {
+        bus->subscribers[bus->dispatch_tails[event_id]].next = idx;
+    }
+    bus->dispatch_tails[event_id] = idx;
     return 0;
 }
 
+#if SAFECORE_PARALLEL_ENABLED == 1
 /**
- * @brief Publish an event with raw data
+ * @brief Subscribe to an event on an instance within an execution domain
+ * 
+ * @param bus Event bus instance
+ * @param event_id ID of the event to subscribe to
+ * @param callback Function to call when the event is published
+ * @param ctx Context pointer to pass to the callback
+ * @param domain Execution domain
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_subscribe_domain(sc_bus_t *bus, uint8_t event_id, sc_subscriber_fn_t callback,
+                            void *ctx, uint8_t domain) {
+    if (sc_bus_subscribe(bus, event_id, callback, ctx) != 0) {
+        return -1;
+    }
+
+    bus->subscribers[bus->subscriber_count - 1U].domain = domain;
+    return 0;
+}
+#endif
+
+/**
+ * @brief Publish an event with raw data on an instance
  * 
- * This function publishes an event using raw data, applying filters if enabled
- * and routing to the appropriate queue based on priority configuration.
+ * This function publishes an event using raw data, applying the instance's
+ * filters if enabled and routing to the appropriate queue based on priority
+ * configuration.
  * 
+ * @param bus Event bus instance
  * @param event_data Pointer to the event data
  * @param size Size of the event data in bytes
  * @return int 0 on success, -1 on failure
  */
-int sc_eventbus_publish_raw(const uint8_t *event_data, size_t size) {
+int sc_bus_publish_raw(sc_bus_t *bus, const uint8_t *event_data, size_t size) {
     /* Validate input parameters */
-    if (!event_data || size == 0U) return -1;
+    if (!bus || !bus->queues || !event_data || size == 0U) return -1;
     
     /* Cast to event structure to check event ID */
     const sc_event_t *e = (const sc_event_t*)event_data;
     if (e->id >= SAFECORE_MAX_EVENT_TYPES) return -1;
 
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+    /* Rate limit summaries marked by earlier filter checks */
+    sc_bus_filters_rate_report(bus);
+#endif
+
+    /* Route to appropriate publishing mechanism based on priority configuration */
+#if SAFECORE_PRIORITY_ENABLED == 1
+    /* The priority module applies the filters */
+    return sc_bus_priority_publish_raw(bus, event_data, size);
+#else
 #if SAFECORE_FILTERS_ENABLED == 1
     /* Apply event filtering if enabled */
-    if (!sc_filters_check_event(e)) {
+    if (!sc_bus_filters_check_event(bus, e, size)) {
         SC_LOG("Event %d filtered out", e->id);
         return 0; /* Filtered out, but not an error */
     }
 #endif
+    return sc_bus_enqueue(bus, 0U, event_data, size);
+#endif
+}
 
-    /* Route to appropriate publishing mechanism based on priority configuration */
-#if SAFECORE_PRIORITY_ENABLED == 1
-    return sc_priority_publish_raw(event_data, size);
+#if SAFECORE_WAIT_ENABLED == 1
+/**
+ * @brief Wake threads blocked in sc_bus_wait() after a publish
+ * 
+ * The fence pairs with the one in sc_bus_wait(): either the waiter sees the
+ * new event, or the producer sees the waiter and bumps the futex word.
+ * 
+ * @param bus Event bus instance
+ */
+static void bus_wake(sc_bus_t *bus) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&bus->waiters, memory_order_relaxed) != 0U) {
+        (void)atomic_fetch_add_explicit(&bus->wake_seq, 1U, memory_order_release);
+        (void)syscall(SYS_futex, (uint32_t *)(void *)&bus->wake_seq, FUTEX_WAKE_PRIVATE, INT_MAX,
+                      NULL, NULL, 0);
+    }
+}
+#endif
+
+/**
+ * @brief Mark a priority level as holding events
+ *
+ * Called after the level's queue committed an event, so a consumer that
+ * clears the bit concurrently sees the event when it re-checks the depth.
+ *
+ * @param bus Event bus instance
+ * @param level Priority level
+ */
+static void bus_ready_set(sc_bus_t *bus, uint8_t level) {
+#if SAFECORE_MPSC_ENABLED == 1
+    (void)atomic_fetch_or_explicit(&bus->ready, (sc_prio_mask_t)1U << level, memory_order_acq_rel);
 #else
-    return queue_push(event_data, size);
+    bus->ready |= (sc_prio_mask_t)1U << level;
 #endif
 }
 
 /**
- * @brief Process events in the event bus
- * 
- * This function processes all pending events in the event bus, delivering
- * them to all matching subscribers. It also performs timeout checks.
+ * @brief Update the ready bit of a level after taking events from it
+ *
+ * @param bus Event bus instance
+ * @param level Priority level
  */
-void sc_eventbus_process(void) {
-    /* Record start time for timeout monitoring */
-    uint32_t start = safecore_get_tick_ms();
+void sc_bus_ready_refresh(sc_bus_t *bus, uint8_t level) {
+    if ((bus == NULL) || (bus->queues == NULL) || (level >= bus->priorities) ||
+        (sc_queue_depth(&bus->queues[level]) != 0U)) {
+        return;
+    }
 
-    /* Process events using the appropriate mechanism */
-#if SAFECORE_PRIORITY_ENABLED == 1
-    sc_priority_process();
+#if SAFECORE_MPSC_ENABLED == 1
+    (void)atomic_fetch_and_explicit(&bus->ready, ~((sc_prio_mask_t)1U << level), memory_order_acq_rel);
 #else
-    const uint8_t *raw;
-    /* Process all events in the queue */
-    while ((raw = queue_pop()) != NULL) {
-        const sc_event_t *e = (const sc_event_t*)raw;
-        
-        /* Deliver event to all matching subscribers */
-        for (uint8_t i = 0; i < g_subscriber_count; i++) {
-            if (g_subscribers[i].event_id == e->id) {
-                if (g_subscribers[i].callback) {
-                    g_subscribers[i].callback(e, g_subscribers[i].ctx);
-                } else {
-                    SAFECORE_ON_ERROR("Null subscriber callback!");
-                }
-            }
-        }
+    bus->ready &= ~((sc_prio_mask_t)1U << level);
+#endif
+
+    /* An event published between the depth check and the clear keeps its bit */
+    if (sc_queue_depth(&bus->queues[level]) != 0U) {
+        bus_ready_set(bus, level);
+    }
+}
+
+/**
+ * @brief Find the next priority level that may hold events
+ *
+ * @param bus Event bus instance
+ * @param from First level to consider
+ * @return uint8_t Lowest ready level at or after from, or bus->priorities if none
+ */
+uint8_t sc_bus_next_ready(const sc_bus_t *bus, uint8_t from) {
+    sc_prio_mask_t mask;
+
+    if ((bus == NULL) || (from >= bus->priorities)) {
+        return (bus != NULL) ? bus->priorities : 0U;
     }
+
+#if SAFECORE_MPSC_ENABLED == 1
+    mask = atomic_load_explicit(&bus->ready, memory_order_acquire);
+#else
+    mask = bus->ready;
 #endif
+    /* Ignore the levels before from */
+    mask &= ~(sc_prio_mask_t)0U << from;
 
-    /* Check for processing timeout */
-    uint32_t elapsed = safecore_get_tick_ms() - start;
-    if (elapsed > SAFECORE_MAX_PROCESS_TIME_MS) {
-        SAFECORE_ON_ERROR("Event processing timeout!");
+    return (mask != 0U) ? sc_prio_mask_first(mask) : bus->priorities;
+}
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Mark a priority level as congested once it reaches its high watermark
+ *
+ * Called after the level's queue committed an event. Only the publish that
+ * sets the bit calls the callback.
+ *
+ * @param bus Event bus instance
+ * @param level Priority level
+ */
+static void bus_congestion_raise(sc_bus_t *bus, uint8_t level) {
+    sc_prio_mask_t bit = (sc_prio_mask_t)1U << level;
+
+    if (sc_queue_depth(&bus->queues[level]) < bus->bp.high[level]) {
+        return;
+    }
+
+#if SAFECORE_MPSC_ENABLED == 1
+    if ((atomic_fetch_or_explicit(&bus->bp.congested, bit, memory_order_acq_rel) & bit) != 0U) {
+        return;
+    }
+#else
+    if ((bus->bp.congested & bit) != 0U) {
+        return;
+    }
+    bus->bp.congested |= bit;
+#endif
+
+    if (bus->bp.callback != NULL) {
+        bus->bp.callback(bus->bp.ctx, level, 1U);
+    }
+}
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+/**
+ * @brief Check whether an event goes to the spill file
+ *
+ * Events of a spilling level go to the file when their queue is full, and
+ * while the file holds events so that they do not overtake older ones.
+ *
+ * @param bus Event bus instance
+ * @param level Priority level of the event
+ * @param size Size of the event in bytes
+ * @return int 1 if the event goes to the spill file, 0 if it goes to the queue
+ */
+static int bus_spill_wanted(const sc_bus_t *bus, uint8_t level, size_t size) {
+    if ((level < SAFECORE_SPILL_MIN_LEVEL) || (size < sizeof(sc_event_t)) ||
+        (sc_spill_is_open(&bus->spill) == 0)) {
+        return 0;
+    }
+
+    return ((sc_spill_pending(&bus->spill) != 0U) ||
+            (sc_queue_can_push(&bus->queues[level], size) == 0)) ? 1 : 0;
+}
+
+/**
+ * @brief Append an event to the spill file
+ *
+ * The copy carries its level in the priority field, so paging it back
+ * needs no other record.
+ *
+ * @param bus Event bus instance
+ * @param level Priority level of the event
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int 0 on success, -1 if the spill file is full
+ */
+static int bus_spill_push(sc_bus_t *bus, uint8_t level, const uint8_t *event_data, size_t size) {
+    uint8_t *rec = sc_spill_reserve(&bus->spill, size);
+    if (rec == NULL) {
+        return -1;
     }
+
+    (void)memcpy(rec, event_data, size);
+    ((sc_event_t *)(void *)rec)->flags = 0U;
+    ((sc_event_t *)(void *)rec)->priority = level;
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+    bus_stamp(rec, size);
+#endif
+    sc_spill_commit(&bus->spill);
+    return 0;
+}
+#endif
+
+/**
+ * @brief Copy a validated event into a priority level queue
+ * 
+ * The flags byte of the queued copy belongs to the bus and is cleared, so
+ * only sc_bus_publish_pooled() can queue a pool handle. Events of a
+ * coalescing ID overwrite their pending event when there is one. Events of
+ * a spilling level may go to the spill file instead.
+ * 
+ * @param bus Event bus instance
+ * @param prio Priority level (must be below bus->priorities)
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int 0 on success, -1 on failure (invalid parameters or event dropped)
+ */
+int sc_bus_enqueue(sc_bus_t *bus, uint8_t prio, const uint8_t *event_data, size_t size) {
+    if ((bus == NULL) || (bus->queues == NULL) || (event_data == NULL) ||
+        (prio >= bus->priorities)) {
+        return -1;
+    }
+
+#if SAFECORE_COALESCE_ENABLED == 1
+    if (bus_coalesce(bus, prio, event_data, size) != 0) {
+        return 0;
+    }
+#endif
+#if SAFECORE_SPILL_ENABLED == 1
+    if (bus_spill_wanted(bus, prio, size) != 0) {
+        return bus_spill_push(bus, prio, event_data, size);
+    }
+#endif
+
+    uint8_t *slot = sc_queue_reserve(&bus->queues[prio], size);
+    if (slot == NULL) {
+        return -1;
+    }
+
+    (void)memcpy(slot, event_data, size);
+    if (size >= sizeof(sc_event_t)) {
+        ((sc_event_t *)(void *)slot)->flags = 0U;
+    }
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+    bus_stamp(slot, size);
+#endif
+#if SAFECORE_COALESCE_ENABLED == 1
+    bus_coalesce_track(bus, prio, slot, size);
+#endif
+
+    int result = sc_queue_commit(&bus->queues[prio], slot);
+    if (result == 0) {
+        bus_ready_set(bus, prio);
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+        bus_congestion_raise(bus, prio);
+#endif
+    }
+#if SAFECORE_WAIT_ENABLED == 1
+    bus_wake(bus);
+#endif
+    return result;
+}
+
+#if SAFECORE_COALESCE_ENABLED == 1
+/**
+ * @brief Enable or disable last-value coalescing for an event ID
+ * 
+ * @param bus Event bus instance
+ * @param event_id Event ID
+ * @param enable 1 to enable, 0 to disable
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_set_coalescing(sc_bus_t *bus, uint8_t event_id, uint8_t enable) {
+    if ((bus == NULL) || (event_id >= SAFECORE_MAX_EVENT_TYPES)) {
+        return -1;
+    }
+
+    bus->pending[event_id].enabled = (enable != 0U) ? 1U : 0U;
+    bus->pending[event_id].slot = NULL;
+    return 0;
+}
+#endif
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Set the watermarks of a priority level
+ * 
+ * @param bus Event bus instance
+ * @param prio Priority level
+ * @param high High watermark in events (greater than low)
+ * @param low Low watermark in events
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_set_watermarks(sc_bus_t *bus, uint8_t prio, uint16_t high, uint16_t low) {
+    if ((bus == NULL) || (bus->queues == NULL) || (prio >= bus->priorities) || (low >= high)) {
+        return -1;
+    }
+
+    bus->bp.high[prio] = high;
+    bus->bp.low[prio] = low;
+    return 0;
+}
+
+/**
+ * @brief Set the callback called on watermark crossings
+ * 
+ * @param bus Event bus instance
+ * @param callback Callback, or NULL to disable
+ * @param ctx Context pointer passed to the callback
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_set_backpressure_callback(sc_bus_t *bus, sc_backpressure_fn_t callback, void *ctx) {
+    if (bus == NULL) {
+        return -1;
+    }
+
+    bus->bp.callback = callback;
+    bus->bp.ctx = ctx;
+    return 0;
+}
+
+/**
+ * @brief Get the congested priority levels of an instance
+ * 
+ * @param bus Event bus instance
+ * @return sc_prio_mask_t Bit set per congested level
+ */
+sc_prio_mask_t sc_bus_get_congestion(const sc_bus_t *bus) {
+    if (bus == NULL) {
+        return 0U;
+    }
+
+#if SAFECORE_MPSC_ENABLED == 1
+    return atomic_load_explicit(&bus->bp.congested, memory_order_acquire);
+#else
+    return bus->bp.congested;
+#endif
+}
+
+/**
+ * @brief Clear the congestion of levels that fell to their low watermark
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_backpressure_update(sc_bus_t *bus) {
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
+
+    sc_prio_mask_t mask = sc_bus_get_congestion(bus);
+    while (mask != 0U) {
+        uint8_t level = sc_prio_mask_first(mask);
+        sc_prio_mask_t bit = (sc_prio_mask_t)1U << level;
+        mask &= ~bit;
+
+        if ((level >= bus->priorities) || (sc_queue_depth(&bus->queues[level]) > bus->bp.low[level])) {
+            continue;
+        }
+
+#if SAFECORE_MPSC_ENABLED == 1
+        (void)atomic_fetch_and_explicit(&bus->bp.congested, ~bit, memory_order_acq_rel);
+#else
+        bus->bp.congested &= ~bit;
+#endif
+        if (bus->bp.callback != NULL) {
+            bus->bp.callback(bus->bp.ctx, level, 0U);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Deliver pending events of an instance on the calling thread
+ * 
+ * @param bus Event bus instance
+ */
+static void bus_process_queues(sc_bus_t *bus) {
+#if SAFECORE_PRIORITY_ENABLED == 1
+    sc_bus_priority_process(bus);
+#else
+    const uint8_t *raw;
+    size_t size;
+    /* An event held by sc_bus_peek() is delivered first */
+    (void)sc_bus_deliver_held(bus);
+    /* Process all events in the queue */
+    while ((raw = sc_queue_pop(&bus->queues[0], &size)) != NULL) {
+        sc_bus_deliver(bus, 0U, (const sc_event_t*)raw);
+    }
+    sc_queue_release(&bus->queues[0]);
+    sc_bus_ready_refresh(bus, 0U);
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+    sc_bus_backpressure_update(bus);
+#endif
+#endif
+}
+
+/**
+ * @brief Process pending events of an instance
+ * 
+ * This function processes the pending events of the instance, delivering
+ * them to all matching subscribers. It also performs timeout checks and
+ * advances the timer wheel.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_process(sc_bus_t *bus) {
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
+
+    /* Record start time for timeout monitoring */
+    uint32_t start = safecore_get_tick_ms();
+
+#if SAFECORE_TIMER_ENABLED == 1
+    /* Expired timers are delivered in the same cycle */
+    sc_timer_process(start);
+#endif
+
+    /* Process events using the appropriate mechanism */
+#if SAFECORE_PARALLEL_ENABLED == 1
+    if (sc_bus_parallel_process(bus) != 0) {
+        /* Worker pool not running: deliver on this thread */
+        bus_process_queues(bus);
+    }
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+    else {
+        sc_bus_backpressure_update(bus);
+    }
+#endif
+#else
+    bus_process_queues(bus);
+#endif
+
+    /* Check for processing timeout */
+    uint32_t elapsed = safecore_get_tick_ms() - start;
+    if (elapsed > SAFECORE_MAX_PROCESS_TIME_MS) {
+        SAFECORE_ON_ERROR("Event processing timeout!");
+    }
+}
+
+#if SAFECORE_WAIT_ENABLED == 1
+/**
+ * @brief Check whether any priority level has a pending event
+ * 
+ * @param bus Event bus instance
+ * @return int 1 if an event is pending, 0 otherwise
+ */
+static int bus_has_events(const sc_bus_t *bus) {
+    uint8_t level;
+
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+    /* Events already moved to the deadline queue */
+    if (sc_edf_count(&bus->sched.edf) != 0U) {
+        return 1;
+    }
+#endif
+
+    /* Only levels with their ready bit set can hold events */
+    for (level = sc_bus_next_ready(bus, 0U); level < bus->priorities;
+         level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+        if (sc_queue_depth(&bus->queues[level]) != 0U) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Block until events are pending on an instance
+ * 
+ * @param bus Event bus instance
+ * @param timeout_ms Timeout in milliseconds, SC_WAIT_FOREVER to wait without limit
+ * @return int 1 if events are pending, 0 on timeout, -1 on invalid parameters
+ */
+int sc_bus_wait(sc_bus_t *bus, uint32_t timeout_ms) {
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return -1;
+    }
+
+    uint32_t seq = atomic_load_explicit(&bus->wake_seq, memory_order_acquire);
+    (void)atomic_fetch_add_explicit(&bus->waiters, 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    int ready = bus_has_events(bus);
+    if ((ready == 0) && (timeout_ms != 0U)) {
+        struct timespec ts;
+        ts.tv_sec = (time_t)(timeout_ms / 1000U);
+        ts.tv_nsec = (long)(timeout_ms % 1000U) * 1000000L;
+
+        /* Returns at once if a producer bumped the word since it was read */
+        (void)syscall(SYS_futex, (uint32_t *)(void *)&bus->wake_seq, FUTEX_WAIT_PRIVATE, seq,
+                      (timeout_ms == SC_WAIT_FOREVER) ? NULL : &ts, NULL, 0);
+        ready = bus_has_events(bus);
+    }
+
+    (void)atomic_fetch_sub_explicit(&bus->waiters, 1U, memory_order_relaxed);
+    return ready;
+}
+#endif
+
+#if SAFECORE_PROCESS_BUDGET_ENABLED == 1
+/**
+ * @brief Get the number of pending events of an instance
+ * 
+ * @param bus Event bus instance
+ * @return uint32_t Number of queued and spilled events over all priority levels
+ */
+static uint32_t bus_pending_events(const sc_bus_t *bus) {
+    uint32_t pending = 0U;
+    uint8_t level;
+
+    for (level = sc_bus_next_ready(bus, 0U); level < bus->priorities;
+         level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+        pending += sc_queue_depth(&bus->queues[level]);
+    }
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+    /* Events already moved to the deadline queue */
+    pending += sc_edf_count(&bus->sched.edf);
+#endif
+#if SAFECORE_SPILL_ENABLED == 1
+    pending += sc_spill_pending(&bus->spill);
+#endif
+
+    return pending;
+}
+
+/**
+ * @brief Process pending events of an instance within a time budget
+ * 
+ * @param bus Event bus instance
+ * @param budget_us Time budget in microseconds
+ * @param remaining Pointer to store the number of events still pending (may be NULL)
+ * @return uint32_t Number of events delivered
+ */
+uint32_t sc_bus_process_budget(sc_bus_t *bus, uint32_t budget_us, uint32_t *remaining) {
+    uint32_t processed = 0U;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        if (remaining != NULL) {
+            *remaining = 0U;
+        }
+        return 0U;
+    }
+
+#if SAFECORE_TIMER_ENABLED == 1
+    /* Expired timers are delivered in the same cycle */
+    sc_timer_process(safecore_get_tick_ms());
+#endif
+
+    uint32_t start = safecore_get_tick_us();
+
+    /* An event held by sc_bus_peek() is delivered first */
+    processed += sc_bus_deliver_held(bus);
+
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+    /* Earliest deadline first; the deadline queue keeps the place between calls */
+    while (sc_bus_priority_edf_step(bus, 1) != 0) {
+        processed++;
+        if ((safecore_get_tick_us() - start) >= budget_us) {
+            break;
+        }
+    }
+#else
+    if (bus->resume_level >= bus->priorities) {
+        bus->resume_level = 0U;
+        bus->resume_count = 0U;
+    }
+
+    /* A cycle counts as idle only if it walked all levels from the first */
+    int full_cycle = (bus->resume_level == 0U) ? 1 : 0;
+    uint32_t cycle_start = processed;
+
+    for (;;) {
+        sc_queue_t *q = &bus->queues[bus->resume_level];
+        const uint8_t *raw = NULL;
+        size_t size;
+
+        /* Checked every pass, as levels may be visited without delivering */
+        if ((processed != 0U) && ((safecore_get_tick_us() - start) >= budget_us)) {
+            /* Budget used up: resume at this level on the next call */
+            sc_queue_release(q);
+            break;
+        }
+
+        if (bus->resume_count < SAFECORE_MAX_EVENTS_PER_CYCLE) {
+            raw = sc_queue_pop(q, &size);
+        }
+
+        if (raw == NULL) {
+            /* Level empty or quota used: move on to the next ready level */
+            sc_queue_release(q);
+            sc_bus_ready_refresh(bus, bus->resume_level);
+            bus->resume_count = 0U;
+            bus->resume_level = sc_bus_next_ready(bus, (uint8_t)(bus->resume_level + 1U));
+            if (bus->resume_level >= bus->priorities) {
+                /* End of cycle: start over while events are pending */
+                bus->resume_level = sc_bus_next_ready(bus, 0U);
+                if ((bus->resume_level >= bus->priorities) ||
+                    ((full_cycle != 0) && (processed == cycle_start))) {
+                    /* Nothing left, or only MPSC slots not yet committed by their producer */
+                    bus->resume_level = 0U;
+                    break;
+                }
+                full_cycle = 1;
+                cycle_start = processed;
+            }
+            continue;
+        }
+
+        sc_bus_deliver(bus, bus->resume_level, (const sc_event_t *)raw);
+        processed++;
+        bus->resume_count++;
+    }
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+    sc_bus_spill_refill(bus);
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+    sc_bus_backpressure_update(bus);
+#endif
+
+    if (remaining != NULL) {
+        *remaining = bus_pending_events(bus);
+    }
+
+    return processed;
+}
+#endif
+
+/**
+ * @brief Get the priority level a batch event is queued at
+ * 
+ * @param bus Event bus instance
+ * @param e Event, may be NULL
+ * @return uint8_t Priority level, 0 for events without a valid priority
+ */
+static uint8_t bus_event_level(const sc_bus_t *bus, const sc_event_t *e) {
+    uint8_t level = 0U;
+
+#if SAFECORE_PRIORITY_ENABLED == 1
+    if (e != NULL) {
+        level = e->priority;
+        /* Validate priority - fallback to lowest priority if out of range */
+        if (level >= bus->priorities) {
+            level = (uint8_t)(bus->priorities - 1U);
+        }
+    }
+#else
+    (void)bus;
+    (void)e;
+#endif
+
+    return level;
+}
+
+/**
+ * @brief Publish an array of events on an instance
+ * 
+ * Makes one pass over the array. Each event is validated, filtered and
+ * staged behind the queue head of its own level; every level that took
+ * events is then published once.
+ * 
+ * @param bus Event bus instance
+ * @param events Array of n pointers to event data
+ * @param sizes Array of n event sizes in bytes
+ * @param n Number of events
+ * @param status Array of n entries to receive an SC_PUBLISH_* code per event (may be NULL)
+ * @return int Number of queued events, -1 on invalid parameters
+ */
+int sc_bus_publish_batch(sc_bus_t *bus, const uint8_t *const events[], const size_t sizes[],
+                         size_t n, int8_t status[]) {
+    sc_prio_mask_t touched = 0U;
+    int queued = 0;
+    size_t i;
+
+    /* Validate input parameters */
+    if ((bus == NULL) || (bus->queues == NULL) || (events == NULL) || (sizes == NULL)) {
+        return -1;
+    }
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+    /* Rate limit summaries marked by earlier filter checks */
+    sc_bus_filters_rate_report(bus);
+#endif
+
+    for (i = 0U; i < n; i++) {
+        const sc_event_t *e = (const sc_event_t *)(const void *)events[i];
+        uint8_t level = bus_event_level(bus, e);
+        sc_queue_t *q = &bus->queues[level];
+        int8_t result;
+
+        if ((e == NULL) || (sizes[i] == 0U) || (e->id >= SAFECORE_MAX_EVENT_TYPES)) {
+            result = SC_PUBLISH_INVALID;
+#if SAFECORE_FILTERS_ENABLED == 1
+        } else if (!sc_bus_filters_check_event(bus, e, sizes[i])) {
+            result = SC_PUBLISH_FILTERED;
+#endif
+#if SAFECORE_COALESCE_ENABLED == 1
+        } else if (bus_coalesce(bus, level, events[i], sizes[i]) != 0) {
+            result = SC_PUBLISH_OK;
+#endif
+#if SAFECORE_SPILL_ENABLED == 1
+        } else if ((level >= SAFECORE_SPILL_MIN_LEVEL) && (sc_spill_is_open(&bus->spill) != 0)) {
+            /* Staging hides the room left, so spilling levels go event by event */
+            result = (sc_bus_enqueue(bus, level, events[i], sizes[i]) == 0) ?
+                     SC_PUBLISH_OK : SC_PUBLISH_DROPPED;
+#endif
+        } else {
+#if SAFECORE_MPSC_ENABLED == 1
+            /* Slots are published one by one in MPSC mode */
+            uint8_t *slot = sc_queue_reserve(q, sizes[i]);
+#else
+            uint8_t *slot = sc_queue_stage(q, sizes[i]);
+#endif
+            if (slot == NULL) {
+                result = SC_PUBLISH_DROPPED;
+            } else {
+                (void)memcpy(slot, events[i], sizes[i]);
+                if (sizes[i] >= sizeof(sc_event_t)) {
+                    ((sc_event_t *)(void *)slot)->flags = 0U;
+                }
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+                bus_stamp(slot, sizes[i]);
+#endif
+#if SAFECORE_COALESCE_ENABLED == 1
+                bus_coalesce_track(bus, level, slot, sizes[i]);
+#endif
+#if SAFECORE_MPSC_ENABLED == 1
+                (void)sc_queue_commit(q, slot);
+#endif
+                result = SC_PUBLISH_OK;
+            }
+        }
+
+        if (result == SC_PUBLISH_OK) {
+            touched |= (sc_prio_mask_t)1U << level;
+            queued++;
+        }
+        if (status != NULL) {
+            status[i] = result;
+        }
+    }
+
+    while (touched != 0U) {
+        uint8_t level = sc_prio_mask_first(touched);
+        touched &= ~((sc_prio_mask_t)1U << level);
+
+#if SAFECORE_MPSC_ENABLED != 1
+        /* One head update for all events of this level */
+        sc_queue_publish(&bus->queues[level]);
+#endif
+        bus_ready_set(bus, level);
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+        bus_congestion_raise(bus, level);
+#endif
+    }
+
+#if SAFECORE_WAIT_ENABLED == 1
+    if (queued > 0) {
+        bus_wake(bus);
+    }
+#endif
+
+    return queued;
+}
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Publish an event on an instance unless its queue is full
+ * 
+ * @param bus Event bus instance
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int SC_PUBLISH_* code
+ */
+int sc_bus_try_publish(sc_bus_t *bus, const uint8_t *event_data, size_t size) {
+    /* Validate input parameters */
+    if ((bus == NULL) || (bus->queues == NULL) || (event_data == NULL) || (size == 0U)) {
+        return SC_PUBLISH_INVALID;
+    }
+
+    const sc_event_t *e = (const sc_event_t *)(const void *)event_data;
+    if (e->id >= SAFECORE_MAX_EVENT_TYPES) {
+        return SC_PUBLISH_INVALID;
+    }
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+    /* Rate limit summaries marked by earlier filter checks */
+    sc_bus_filters_rate_report(bus);
+#endif
+
+#if SAFECORE_FILTERS_ENABLED == 1
+    if (!sc_bus_filters_check_event(bus, e, size)) {
+        return SC_PUBLISH_FILTERED;
+    }
+#endif
+
+    uint8_t level = bus_event_level(bus, e);
+#if SAFECORE_COALESCE_ENABLED == 1
+    /* Overwriting the pending event takes no room */
+    if (bus_coalesce(bus, level, event_data, size) == 0) {
+#endif
+#if SAFECORE_SPILL_ENABLED == 1
+        if (bus_spill_wanted(bus, level, size) != 0) {
+            if (bus_spill_push(bus, level, event_data, size) != 0) {
+                return SC_PUBLISH_FULL; /* Spill file full */
+            }
+        } else
+#endif
+        if (sc_queue_can_push(&bus->queues[level], size) == 0) {
+            return SC_PUBLISH_FULL; /* Left with the caller, overflow policy not applied */
+        } else if (sc_bus_enqueue(bus, level, event_data, size) != 0) {
+            return SC_PUBLISH_DROPPED;
+        } else {
+            /* Queued */
+        }
+#if SAFECORE_COALESCE_ENABLED == 1
+    }
+#endif
+
+    return ((sc_bus_get_congestion(bus) & ((sc_prio_mask_t)1U << level)) != 0U) ?
+           SC_PUBLISH_CONGESTED : SC_PUBLISH_OK;
+}
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+/**
+ * @brief Open the spill file of an instance
+ * 
+ * @param bus Event bus instance
+ * @param path Path of the backing file
+ * @param bytes File size in bytes
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_spill_open(sc_bus_t *bus, const char *path, uint32_t bytes) {
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return -1;
+    }
+
+    return sc_spill_open(&bus->spill, path, bytes);
+}
+
+/**
+ * @brief Close the spill file of an instance
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_spill_close(sc_bus_t *bus) {
+    if (bus != NULL) {
+        sc_spill_close(&bus->spill);
+    }
+}
+
+/**
+ * @brief Get the number of events waiting in the spill file
+ * 
+ * @param bus Event bus instance
+ * @return uint32_t Number of spilled events not yet paged back
+ */
+uint32_t sc_bus_spill_pending(const sc_bus_t *bus) {
+    return (bus != NULL) ? sc_spill_pending(&bus->spill) : 0U;
+}
+
+/**
+ * @brief Page spilled events back into their queues
+ * 
+ * A spilled event is committed to its queue before it leaves the file, so
+ * a producer that finds the file empty cannot overtake it.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_spill_refill(sc_bus_t *bus) {
+    const uint8_t *rec;
+    size_t size;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
+
+    while ((rec = sc_spill_peek(&bus->spill, &size)) != NULL) {
+        uint8_t level = bus_event_level(bus, (const sc_event_t *)(const void *)rec);
+        sc_queue_t *q = &bus->queues[level];
+
+        /* Keep the file order: wait until the level has room */
+        if (sc_queue_can_push(q, size) == 0) {
+            break;
+        }
+
+        uint8_t *slot = sc_queue_reserve(q, size);
+        if (slot == NULL) {
+            break;
+        }
+        (void)memcpy(slot, rec, size);
+        if (sc_queue_commit(q, slot) == 0) {
+            bus_ready_set(bus, level);
+        }
+        sc_spill_release(&bus->spill);
+    }
+}
+#endif
+
+#if SAFECORE_PROCESS_BATCH_ENABLED == 1
+/**
+ * @brief Deliver a batch of events grouped by event ID
+ * 
+ * For each event ID in order of first appearance, walks the ID's dispatch
+ * chain once and hands every event of that ID to each subscriber in turn.
+ * 
+ * @param bus Event bus instance
+ * @param events Events to deliver
+ * @param count Number of events (at most SAFECORE_BATCH_MAX_EVENTS)
+ */
+static void bus_dispatch_grouped(const sc_bus_t *bus, const uint8_t *const events[], uint16_t count) {
+    uint8_t done[SAFECORE_BATCH_MAX_EVENTS];
+    uint16_t i;
+    uint16_t j;
+
+    (void)memset(done, 0, sizeof(done));
+
+    for (i = 0U; i < count; i++) {
+        if (done[i] != 0U) {
+            continue;
+        }
+
+        uint8_t id = ((const sc_event_t *)(const void *)events[i])->id;
+        sc_subscriber_index_t sub_idx = (id < SAFECORE_MAX_EVENT_TYPES) ?
+                                        bus->dispatch_heads[id] : SC_SUBSCRIBER_NONE;
+
+        while (sub_idx != SC_SUBSCRIBER_NONE) {
+            const subscriber_entry_t *sub = &bus->subscribers[sub_idx];
+            if (sub->callback != NULL) {
+                for (j = i; j < count; j++) {
+                    const sc_event_t *e = (const sc_event_t *)(const void *)events[j];
+                    if ((done[j] == 0U) && (e->id == id)) {
+                        sub->callback(e, sub->ctx);
+                    }
+                }
+            } else {
+                SAFECORE_ON_ERROR("Null subscriber callback!");
+            }
+            sub_idx = sub->next;
+        }
+
+        /* Mark the whole group delivered */
+        for (j = i; j < count; j++) {
+            if (((const sc_event_t *)(const void *)events[j])->id == id) {
+                done[j] = 1U;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Process pending events of an instance in batches
+ * 
+ * Peeks up to max_per_level events of each level in place, delivers them
+ * grouped by event ID and releases them together. Performs the same timeout
+ * check as sc_bus_process().
+ * 
+ * @param bus Event bus instance
+ * @param max_per_level Events per level, 0 or more than SAFECORE_BATCH_MAX_EVENTS means SAFECORE_BATCH_MAX_EVENTS
+ */
+void sc_bus_process_batch(sc_bus_t *bus, uint16_t max_per_level) {
+    const uint8_t *events[SAFECORE_BATCH_MAX_EVENTS];
+    size_t sizes[SAFECORE_BATCH_MAX_EVENTS];
+    uint8_t level;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
+
+    if ((max_per_level == 0U) || (max_per_level > SAFECORE_BATCH_MAX_EVENTS)) {
+        max_per_level = SAFECORE_BATCH_MAX_EVENTS;
+    }
+
+    /* Record start time for timeout monitoring */
+    uint32_t start = safecore_get_tick_ms();
+
+#if SAFECORE_TIMER_ENABLED == 1
+    /* Expired timers are delivered in the same cycle */
+    sc_timer_process(start);
+#endif
+
+    /* An event held by sc_bus_peek() is delivered first */
+    (void)sc_bus_deliver_held(bus);
+
+    /* Highest priority level first, skipping empty levels */
+    for (level = sc_bus_next_ready(bus, 0U); level < bus->priorities;
+         level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+        uint16_t count = sc_queue_peek_batch(&bus->queues[level], events, sizes, max_per_level);
+        if (count > 0U) {
+            bus_dispatch_grouped(bus, events, count);
+            sc_queue_release(&bus->queues[level]);
+        }
+        sc_bus_ready_refresh(bus, level);
+    }
+
+#if SAFECORE_SPILL_ENABLED == 1
+    sc_bus_spill_refill(bus);
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+    sc_bus_backpressure_update(bus);
+#endif
+
+    /* Check for processing timeout */
+    uint32_t elapsed = safecore_get_tick_ms() - start;
+    if (elapsed > SAFECORE_MAX_PROCESS_TIME_MS) {
+        SAFECORE_ON_ERROR("Event processing timeout!");
+    }
+}
+#endif
+
+/**
+ * @brief Deliver an event to the subscribers of an instance
+ * 
+ * This function walks the dispatch chain of the event's ID, so only the
+ * subscribers of that event type are visited.
+ * 
+ * @param bus Event bus instance
+ * @param e Pointer to the event to deliver
+ */
+void sc_bus_dispatch(const sc_bus_t *bus, const sc_event_t *e) {
+    if ((bus == NULL) || (e == NULL) || (e->id >= SAFECORE_MAX_EVENT_TYPES)) {
+        return;
+    }
+
+    sc_subscriber_index_t i = bus->dispatch_heads[e->id];
+    while (i != SC_SUBSCRIBER_NONE) {
+        const subscriber_entry_t *sub = &bus->subscribers[i];
+        if (sub->callback != NULL) {
+            sub->callback(e, sub->ctx);
+        } else {
+            SAFECORE_ON_ERROR("Null subscriber callback!");
+        }
+        i = sub->next;
+    }
+}
+
+/**
+ * @brief Deliver an event taken from a priority level queue
+ * 
+ * The queue wait runs from the enqueue stamp to the start of delivery; the
+ * callback time covers all subscribers of the event.
+ * 
+ * @param bus Event bus instance
+ * @param level Priority level the event was taken from
+ * @param e Pointer to the event to deliver
+ */
+void sc_bus_deliver(sc_bus_t *bus, uint8_t level, const sc_event_t *e) {
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+    if ((bus == NULL) || (bus->queues == NULL) || (e == NULL) || (level >= bus->priorities)) {
+        sc_bus_dispatch(bus, e);
+        return;
+    }
+
+    uint8_t id = e->id;
+    uint32_t start = safecore_get_tick_us();
+    uint32_t wait = start - e->timestampMicro;
+
+    sc_hist_record(&bus->hist.wait_us[level], wait);
+    sc_hist_record(&bus->hist.depth[level], sc_queue_depth(&bus->queues[level]));
+
+    sc_bus_dispatch(bus, e);
+
+    uint32_t spent = safecore_get_tick_us() - start;
+    sc_hist_record(&bus->hist.callback_us[level], spent);
+#if SAFECORE_HIST_PER_ID_ENABLED == 1
+    if (id < SAFECORE_MAX_EVENT_TYPES) {
+        sc_hist_record(&bus->hist.id_wait_us[id], wait);
+        sc_hist_record(&bus->hist.id_callback_us[id], spent);
+    }
+#else
+    (void)id;
+#endif
+#else
+    (void)level;
+    sc_bus_dispatch(bus, e);
+#endif
+}
+
+/**
+ * @brief Deliver the event held by sc_bus_peek() ahead of all others
+ * 
+ * The held event is the one the application was shown as next, so every
+ * processing path delivers it before any other event.
+ * 
+ * @param bus Event bus instance
+ * @return uint32_t Number of events delivered (0 or 1)
+ */
+uint32_t sc_bus_deliver_held(sc_bus_t *bus) {
+    const uint8_t *raw;
+    size_t size;
+
+    if ((bus == NULL) || (bus->queues == NULL) || (bus->peek_level == SC_BUS_NO_LEVEL)) {
+        return 0U;
+    }
+
+    uint8_t level = bus->peek_level;
+    bus->peek_level = SC_BUS_NO_LEVEL;
+    raw = sc_queue_peek(&bus->queues[level], &size);
+    if (raw != NULL) {
+        sc_bus_deliver(bus, level, (const sc_event_t *)(const void *)raw);
+    }
+    sc_queue_release(&bus->queues[level]);
+    sc_bus_ready_refresh(bus, level);
+
+    return (raw != NULL) ? 1U : 0U;
+}
+
+/**
+ * @brief Reserve a queue slot to build an event in place
+ * 
+ * @param bus Event bus instance
+ * @param prio Priority level (ignored without priority support)
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure
+ */
+uint8_t* sc_bus_reserve(sc_bus_t *bus, uint8_t prio, size_t size) {
+    if ((bus == NULL) || (bus->queues == NULL) || (size < sizeof(sc_event_t))) {
+        return NULL;
+    }
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+    /* Rate limit summaries marked by earlier filter checks */
+    sc_bus_filters_rate_report(bus);
+#endif
+
+#if SAFECORE_PRIORITY_ENABLED == 1
+    /* Fall back to the lowest priority level if out of range */
+    if (prio >= bus->priorities) {
+        prio = (uint8_t)(bus->priorities - 1U);
+    }
+#else
+    prio = 0U;
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+    /* An event built in the queue would overtake the spilled ones */
+    if ((prio >= SAFECORE_SPILL_MIN_LEVEL) && (sc_spill_pending(&bus->spill) != 0U)) {
+        return NULL;
+    }
+#endif
+
+    return sc_queue_reserve(&bus->queues[prio], size);
+}
+
+/**
+ * @brief Publish an event built in a reserved slot with the given flags
+ * 
+ * Finds the queue owning the slot, validates and filters the event, then
+ * commits the slot or discards it.
+ * 
+ * @param bus Event bus instance
+ * @param event Pointer returned by sc_bus_reserve()
+ * @param flags SC_EVENT_FLAG_* flags to store in the event
+ * @return int 0 on success (including filtered events), -1 on failure
+ */
+static int bus_commit(sc_bus_t *bus, uint8_t *event, uint8_t flags) {
+    if ((bus == NULL) || (bus->queues == NULL) || (event == NULL)) {
+        return -1;
+    }
+
+    /* Find the priority level whose storage holds the event */
+    uint8_t prio;
+    sc_queue_t *q = NULL;
+    for (prio = 0U; prio < bus->priorities; prio++) {
+        if (sc_queue_owns(&bus->queues[prio], event) != 0) {
+            q = &bus->queues[prio];
+            break;
+        }
+    }
+    if (q == NULL) {
+        return -1;
+    }
+
+    sc_event_t *e = (sc_event_t *)(void *)event;
+    e->flags = flags;
+    if (e->id >= SAFECORE_MAX_EVENT_TYPES) {
+        (void)sc_queue_discard(q, event);
+        return -1;
+    }
+#if SAFECORE_PRIORITY_ENABLED == 1
+    e->priority = prio;
+#endif
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+    bus_stamp(event, sizeof(sc_event_t));
+#endif
+
+#if SAFECORE_FILTERS_ENABLED == 1
+    /* Apply event filtering if enabled; programs read no further than the reservation */
+    if (!sc_bus_filters_check_event(bus, e, sc_queue_reserved_size(q, event))) {
+        SC_LOG("Event %d filtered out", e->id);
+        return sc_queue_discard(q, event); /* Filtered out, but not an error */
+    }
+#endif
+
+    int result = sc_queue_commit(q, event);
+    if (result == 0) {
+        bus_ready_set(bus, prio);
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+        bus_congestion_raise(bus, prio);
+#endif
+    }
+#if SAFECORE_WAIT_ENABLED == 1
+    bus_wake(bus);
+#endif
+    return result;
+}
+
+/**
+ * @brief Publish an event built in a reserved slot
+ * 
+ * @param bus Event bus instance
+ * @param event Pointer returned by sc_bus_reserve()
+ * @return int 0 on success (including filtered events), -1 on failure
+ */
+int sc_bus_commit(sc_bus_t *bus, uint8_t *event) {
+    return bus_commit(bus, event, 0U);
+}
+
+#if SAFECORE_POOL_ENABLED == 1
+/**
+ * @brief Publish a pool payload as a handle event
+ * 
+ * Queues only the payload's handle. The caller's reference moves to the
+ * queued event and is dropped after delivery, so subscribers that keep the
+ * payload must retain it. On failure or filtering the reference is dropped.
+ * 
+ * @param bus Event bus instance
+ * @param id Event ID
+ * @param prio Priority level (ignored without priority support)
+ * @param payload Pointer returned by sc_pool_alloc()
+ * @return int 0 on success (including filtered events), -1 on failure
+ */
+int sc_bus_publish_pooled(sc_bus_t *bus, uint8_t id, uint8_t prio, void *payload) {
+    sc_pool_handle_t handle = sc_pool_handle(payload);
+    if (handle == SC_POOL_HANDLE_NONE) {
+        return -1;
+    }
+
+    sc_pool_event_t *ev = (sc_pool_event_t *)(void *)sc_bus_reserve(bus, prio, sizeof(sc_pool_event_t));
+    if (ev == NULL) {
+        sc_pool_release(payload);
+        return -1;
+    }
+
+    (void)memset(ev, 0, sizeof(*ev));
+    ev->header.timestamp = safecore_get_tick_ms();
+    ev->header.id = id;
+    ev->header.size = (uint8_t)sizeof(sc_pool_event_t);
+    ev->handle = handle;
+
+    /* A discarded handle event drops its reference through the queue free hook */
+    return bus_commit(bus, (uint8_t *)ev, SC_EVENT_FLAG_POOLED);
+}
+#endif
+
+/**
+ * @brief Look at the next pending event in place
+ * 
+ * @param bus Event bus instance
+ * @param out_size Pointer to store the size of the event (may be NULL)
+ * @return const sc_event_t* Pointer to the event, or NULL if no event is pending
+ */
+const sc_event_t* sc_bus_peek(sc_bus_t *bus, size_t *out_size) {
+    const uint8_t *raw = NULL;
+    size_t size = 0U;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return NULL;
+    }
+
+    if (bus->peek_level != SC_BUS_NO_LEVEL) {
+        /* Still holding an event: return it again */
+        raw = sc_queue_peek(&bus->queues[bus->peek_level], &size);
+    } else {
+        uint8_t prio;
+        /* Highest ready priority level first */
+        for (prio = sc_bus_next_ready(bus, 0U); (prio < bus->priorities) && (raw == NULL);
+             prio = sc_bus_next_ready(bus, (uint8_t)(prio + 1U))) {
+            raw = sc_queue_peek(&bus->queues[prio], &size);
+            if (raw != NULL) {
+                bus->peek_level = prio;
+            } else {
+                sc_bus_ready_refresh(bus, prio);
+            }
+        }
+    }
+
+    if ((raw != NULL) && (out_size != NULL)) {
+        *out_size = size;
+    }
+
+    return (const sc_event_t *)(const void *)raw;
+}
+
+/**
+ * @brief Remove the event returned by sc_bus_peek()
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_release(sc_bus_t *bus) {
+    if ((bus != NULL) && (bus->queues != NULL) && (bus->peek_level != SC_BUS_NO_LEVEL)) {
+        sc_queue_release(&bus->queues[bus->peek_level]);
+        sc_bus_ready_refresh(bus, bus->peek_level);
+        bus->peek_level = SC_BUS_NO_LEVEL;
+#if SAFECORE_SPILL_ENABLED == 1
+        sc_bus_spill_refill(bus);
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+        sc_bus_backpressure_update(bus);
+#endif
+    }
+}
+
+/* === Default Instance API === */
+
+/**
+ * @brief Get the default event bus instance
+ * 
+ * @return sc_bus_t* Pointer to the default instance
+ */
+sc_bus_t* sc_eventbus_default(void) {
+    return &g_default_bus;
+}
+
+/**
+ * @brief Initialize the event bus
+ * 
+ * This function initializes the default instance, resetting subscribers,
+ * queue pointers and filter rules.
+ */
+void sc_eventbus_init(void) {
+    if (sc_bus_init(&g_default_bus, &g_default_bus_cfg, g_default_bus_storage,
+                    sizeof(g_default_bus_storage)) != 0) {
+        SAFECORE_ON_ERROR("Event bus init failed");
+    }
+#if SAFECORE_TIMER_ENABLED == 1
+    sc_timer_init();
+#endif
+}
+
+/**
+ * @brief Subscribe to an event
+ * 
+ * This function registers a callback on the default instance.
+ * 
+ * @param event_id ID of the event to subscribe to
+ * @param callback Function to call when the event is published
+ * @param ctx Context pointer to pass to the callback
+ * @return int 0 on success, -1 on failure
+ */
+int sc_eventbus_subscribe(uint8_t event_id, sc_subscriber_fn_t callback, void *ctx) {
+    return sc_bus_subscribe(&g_default_bus, event_id, callback, ctx);
+}
+
+#if SAFECORE_PARALLEL_ENABLED == 1
+/**
+ * @brief Subscribe to an event within an execution domain
+ * 
+ * @param event_id ID of the event to subscribe to
+ * @param callback Function to call when the event is published
+ * @param ctx Context pointer to pass to the callback
+ * @param domain Execution domain
+ * @return int 0 on success, -1 on failure
+ */
+int sc_eventbus_subscribe_domain(uint8_t event_id, sc_subscriber_fn_t callback, void *ctx,
+                                 uint8_t domain) {
+    return sc_bus_subscribe_domain(&g_default_bus, event_id, callback, ctx, domain);
+}
+#endif
+
+/**
+ * @brief Publish an event with raw data
+ * 
+ * This function publishes an event on the default instance.
+ * 
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int 0 on success, -1 on failure
+ */
+int sc_eventbus_publish_raw(const uint8_t *event_data, size_t size) {
+    return sc_bus_publish_raw(&g_default_bus, event_data, size);
+}
+
+/**
+ * @brief Process events in the event bus
+ * 
+ * This function processes all pending events of the default instance.
+ */
+void sc_eventbus_process(void) {
+    sc_bus_process(&g_default_bus);
+}
+
+#if SAFECORE_WAIT_ENABLED == 1
+/**
+ * @brief Block until there is work for sc_eventbus_process()
+ * 
+ * @param timeout_ms Timeout in milliseconds, SC_WAIT_FOREVER to wait without limit
+ * @return int 1 if events are pending, 0 otherwise
+ */
+int sc_eventbus_wait(uint32_t timeout_ms) {
+#if SAFECORE_TIMER_ENABLED == 1
+    uint32_t delay;
+
+    /* Tickless: sleep no longer than until the next timer is due */
+    if ((sc_timer_next_expiry(safecore_get_tick_ms(), &delay) == 0) && (delay < timeout_ms)) {
+        timeout_ms = delay;
+    }
+#endif
+    return (sc_bus_wait(&g_default_bus, timeout_ms) > 0) ? 1 : 0;
+}
+#endif
+
+#if SAFECORE_PROCESS_BUDGET_ENABLED == 1
+/**
+ * @brief Process events within a time budget
+ * 
+ * @param budget_us Time budget in microseconds
+ * @param remaining Pointer to store the number of events still pending (may be NULL)
+ * @return uint32_t Number of events delivered
+ */
+uint32_t sc_eventbus_process_budget(uint32_t budget_us, uint32_t *remaining) {
+    return sc_bus_process_budget(&g_default_bus, budget_us, remaining);
+}
+#endif
+
+/**
+ * @brief Publish an array of events
+ * 
+ * @param events Array of n pointers to event data
+ * @param sizes Array of n event sizes in bytes
+ * @param n Number of events
+ * @param status Array of n entries to receive an SC_PUBLISH_* code per event (may be NULL)
+ * @return int Number of queued events, -1 on invalid parameters
+ */
+int sc_eventbus_publish_batch(const uint8_t *const events[], const size_t sizes[], size_t n,
+                              int8_t status[]) {
+    return sc_bus_publish_batch(&g_default_bus, events, sizes, n, status);
+}
+
+#if SAFECORE_PROCESS_BATCH_ENABLED == 1
+/**
+ * @brief Process events in batches grouped by event ID
+ * 
+ * @param max_per_level Maximum events per priority level
+ */
+void sc_eventbus_process_batch(uint16_t max_per_level) {
+    sc_bus_process_batch(&g_default_bus, max_per_level);
+}
+#endif
+
+#if SAFECORE_COALESCE_ENABLED == 1
+/**
+ * @brief Enable or disable last-value coalescing for an event ID
+ * 
+ * @param event_id Event ID
+ * @param enable 1 to enable, 0 to disable
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_eventbus_set_coalescing(uint8_t event_id, uint8_t enable) {
+    return sc_bus_set_coalescing(&g_default_bus, event_id, enable);
+}
+#endif
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Publish an event unless its queue is full
+ * 
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int SC_PUBLISH_* code, see sc_bus_try_publish()
+ */
+int sc_eventbus_try_publish(const uint8_t *event_data, size_t size) {
+    return sc_bus_try_publish(&g_default_bus, event_data, size);
+}
+
+/**
+ * @brief Set the watermarks of a priority level
+ * 
+ * @param prio Priority level
+ * @param high High watermark in events (greater than low)
+ * @param low Low watermark in events
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_eventbus_set_watermarks(uint8_t prio, uint16_t high, uint16_t low) {
+    return sc_bus_set_watermarks(&g_default_bus, prio, high, low);
+}
+
+/**
+ * @brief Set the callback called on watermark crossings
+ * 
+ * @param callback Callback, or NULL to disable
+ * @param ctx Context pointer passed to the callback
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_eventbus_set_backpressure_callback(sc_backpressure_fn_t callback, void *ctx) {
+    return sc_bus_set_backpressure_callback(&g_default_bus, callback, ctx);
+}
+
+/**
+ * @brief Get the congested priority levels
+ * 
+ * @return sc_prio_mask_t Bit set per congested level
+ */
+sc_prio_mask_t sc_eventbus_get_congestion(void) {
+    return sc_bus_get_congestion(&g_default_bus);
+}
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+/**
+ * @brief Open the spill file of the low priority levels
+ * 
+ * @param path Path of the backing file
+ * @param bytes File size in bytes
+ * @return int 0 on success, -1 on failure
+ */
+int sc_eventbus_spill_open(const char *path, uint32_t bytes) {
+    return sc_bus_spill_open(&g_default_bus, path, bytes);
+}
+
+/**
+ * @brief Close the spill file, losing the events still in it
+ */
+void sc_eventbus_spill_close(void) {
+    sc_bus_spill_close(&g_default_bus);
+}
+
+/**
+ * @brief Get the number of events waiting in the spill file
+ * 
+ * @return uint32_t Number of spilled events not yet paged back
+ */
+uint32_t sc_eventbus_spill_pending(void) {
+    return sc_bus_spill_pending(&g_default_bus);
+}
+#endif
+
+/**
+ * @brief Deliver an event to its subscribers
+ * 
+ * This function delivers an event to the subscribers of the default instance.
+ * 
+ * @param e Pointer to the event to deliver
+ */
+void sc_eventbus_dispatch(const sc_event_t *e) {
+    sc_bus_dispatch(&g_default_bus, e);
+}
+
+/**
+ * @brief Reserve a queue slot to build an event in place
+ * 
+ * @param prio Priority level (ignored without priority support)
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure
+ */
+uint8_t* sc_eventbus_reserve(uint8_t prio, size_t size) {
+    return sc_bus_reserve(&g_default_bus, prio, size);
+}
+
+/**
+ * @brief Publish an event built in a reserved slot
+ * 
+ * @param event Pointer returned by sc_eventbus_reserve()
+ * @return int 0 on success (including filtered events), -1 on failure
+ */
+int sc_eventbus_commit(uint8_t *event) {
+    return sc_bus_commit(&g_default_bus, event);
+}
+
+#if SAFECORE_POOL_ENABLED == 1
+/**
+ * @brief Publish a pool payload as a handle event
+ * 
+ * @param id Event ID
+ * @param prio Priority level (ignored without priority support)
+ * @param payload Pointer returned by sc_pool_alloc()
+ * @return int 0 on success (including filtered events), -1 on failure
+ */
+int sc_eventbus_publish_pooled(uint8_t id, uint8_t prio, void *payload) {
+    return sc_bus_publish_pooled(&g_default_bus, id, prio, payload);
+}
+#endif
+
+/**
+ * @brief Look at the next pending event in place
+ * 
+ * @param out_size Pointer to store the size of the event (may be NULL)
+ * @return const sc_event_t* Pointer to the event, or NULL if no event is pending
+ */
+const sc_event_t* sc_eventbus_peek(size_t *out_size) {
+    return sc_bus_peek(&g_default_bus, out_size);
+}
+
+/**
+ * @brief Remove the event returned by sc_eventbus_peek()
+ */
+void sc_eventbus_release(void) {
+    sc_bus_release(&g_default_bus);
 }
 
 #endif /* SAFECORE_BASIC_ENABLED */
\ No newline at end of file
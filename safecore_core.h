@@ -10,6 +10,13 @@
 
 #include "safecore_types.h"
 #include "safecore_config.h"
+#include "safecore_queue.h"
+#include "safecore_edf.h"
+#include "safecore_hist.h"
+#include "safecore_spill.h"
+#if (SAFECORE_WAIT_ENABLED == 1) || (SAFECORE_MPSC_ENABLED == 1)
+#include <stdatomic.h>
+#endif
 
 /**
  * @defgroup StateMachine State Machine Module
@@ -33,17 +40,32 @@ typedef struct {
 } sc_state_machine_t;
 
 /* === Subscriber Table Structure === */
+/**
+ * @brief Subscriber table index type
+ * 
+ * Index into the subscriber table. SC_SUBSCRIBER_NONE terminates a
+ * per-event-type dispatch chain.
+ */
+typedef uint16_t sc_subscriber_index_t;
+#define SC_SUBSCRIBER_NONE  ((sc_subscriber_index_t)0xFFFFU)
+
+/* Marker for "no event held by sc_bus_peek()" */
+#define SC_BUS_NO_LEVEL     0xFFU
+
 /**
  * @brief Subscriber entry structure
  * 
  * This structure stores information about an event subscriber,
  * including the event ID to subscribe to, the callback function,
- * and the user context.
+ * and the user context. Subscribers of the same event ID are linked
+ * through the next index so delivery only visits matching entries.
  */
 typedef struct {
     uint8_t event_id;          /* Event ID to subscribe to */
     sc_subscriber_fn_t callback; /* Callback function for event processing */
     void *ctx;                 /* User context for the callback */
+    sc_subscriber_index_t next; /* Next subscriber of the same event ID */
+    uint8_t domain;            /* Execution domain for parallel dispatch */
 } subscriber_entry_t;
 
 /**
@@ -100,6 +122,630 @@ void sc_sm_send_exit(sc_state_machine_t *sm, void *ctx);
  * @{*/
 #if SAFECORE_BASIC_ENABLED == 1
 
+/**
+ * @brief Queue sizes of one priority level
+ */
+typedef struct {
+    uint16_t queue_size;        /* Slots (power of 2), ring bytes in variable-length mode */
+    uint16_t max_event_size;    /* Maximum event size in bytes */
+} sc_bus_level_config_t;
+
+/**
+ * @brief Event bus instance configuration
+ * 
+ * Storage sizes of one event bus instance. The memory for these is provided
+ * by the caller at sc_bus_init() time. With a levels table each priority
+ * level gets its own queue size and maximum event size, and queue_size and
+ * max_event_size are ignored. Under EDF scheduling no level may take events
+ * larger than SAFECORE_MAX_EVENT_SIZE, the size of a deadline queue slot.
+ */
+typedef struct {
+    uint16_t max_subscribers;   /* Maximum number of subscribers */
+    uint16_t queue_size;        /* Slots per priority level (power of 2), ring bytes in variable-length mode */
+    uint16_t max_event_size;    /* Maximum event size in bytes */
+    uint8_t priorities;         /* Number of priority levels (1 without priority support) */
+    uint8_t max_filter_rules;   /* Maximum number of filter rules */
+    const sc_bus_level_config_t *levels; /* Per-level sizes (priorities entries), NULL for uniform levels */
+} sc_bus_config_t;
+
+#if SAFECORE_COALESCE_ENABLED == 1
+/**
+ * @brief Pending event of a coalescing event ID
+ */
+typedef struct {
+    uint8_t *slot;              /* Queued, not yet taken event, or NULL */
+    uint16_t size;              /* Size of the queued event */
+    uint8_t level;              /* Priority level of the queued event */
+    uint8_t enabled;            /* Coalescing enabled for this ID */
+} sc_bus_pending_t;
+#endif
+
+#if SAFECORE_PRIORITY_ENABLED == 1
+/**
+ * @brief Scheduling state and service counters of the priority levels
+ */
+typedef struct {
+    uint32_t served[SAFECORE_EVENT_PRIORITIES];      /* Events delivered per level */
+    uint32_t max_wait_ms[SAFECORE_EVENT_PRIORITIES]; /* Longest time a ready level went unserved */
+    uint32_t since[SAFECORE_EVENT_PRIORITIES];       /* Time the level became ready or was last served */
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR
+    uint32_t deficit[SAFECORE_EVENT_PRIORITIES];     /* Bytes the level may still deliver this round */
+    uint16_t weight[SAFECORE_EVENT_PRIORITIES];      /* Bytes added to the deficit per round */
+#endif
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+    uint32_t missed[SAFECORE_EVENT_PRIORITIES];      /* Events delivered after their deadline */
+    sc_edf_t edf;                                    /* Events taken from the levels, by deadline */
+#endif
+    sc_prio_mask_t waiting;                          /* Levels whose since entry is valid */
+} sc_bus_sched_t;
+#endif
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+/**
+ * @brief Latency and depth histograms of an event bus instance
+ * 
+ * Recorded by the consumer for every event delivered from a queue: the
+ * time from enqueue to the start of delivery, the time spent in the
+ * subscriber callbacks, both in microseconds, and the depth of the event's
+ * level queue at delivery. The largest depth is the level's peak depth.
+ */
+typedef struct {
+    sc_hist_t wait_us[SAFECORE_EVENT_PRIORITIES];       /* Queue wait per level */
+    sc_hist_t callback_us[SAFECORE_EVENT_PRIORITIES];   /* Callback time per level */
+    sc_hist_t depth[SAFECORE_EVENT_PRIORITIES];         /* Queue depth at delivery per level */
+#if SAFECORE_HIST_PER_ID_ENABLED == 1
+    sc_hist_t id_wait_us[SAFECORE_MAX_EVENT_TYPES];     /* Queue wait per event ID */
+    sc_hist_t id_callback_us[SAFECORE_MAX_EVENT_TYPES]; /* Callback time per event ID */
+#endif
+} sc_bus_hist_t;
+#endif
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Congestion callback type
+ * 
+ * Called with congested = 1 when a level's depth reaches its high watermark,
+ * from the publishing context, and with congested = 0 when it has fallen to
+ * its low watermark, from the processing context.
+ * 
+ * @param ctx Context pointer passed to sc_bus_set_backpressure_callback()
+ * @param level Priority level
+ * @param congested 1 if the level became congested, 0 if it recovered
+ */
+typedef void (*sc_backpressure_fn_t)(void *ctx, uint8_t level, uint8_t congested);
+
+/**
+ * @brief Backpressure state of an event bus instance
+ */
+typedef struct {
+    uint16_t high[SAFECORE_TOTAL_QUEUES];   /* Depth at which a level becomes congested */
+    uint16_t low[SAFECORE_TOTAL_QUEUES];    /* Depth at which a congested level recovers */
+#if SAFECORE_MPSC_ENABLED == 1
+    _Atomic sc_prio_mask_t congested;       /* Bit set per congested level */
+#else
+    sc_prio_mask_t congested;               /* Bit set per congested level */
+#endif
+    sc_backpressure_fn_t callback;          /* Called on watermark crossings (may be NULL) */
+    void *ctx;                              /* Context passed to the callback */
+} sc_bus_backpressure_t;
+#endif
+
+/**
+ * @brief Event bus instance
+ * 
+ * Holds the complete state of one event bus: subscriber table, dispatch
+ * index, per-priority queues and filter rules. Independent instances share
+ * no state and may be driven from different threads or cores.
+ */
+typedef struct {
+    subscriber_entry_t *subscribers;    /* Subscriber table */
+    uint16_t subscriber_count;          /* Current number of subscribers */
+    uint16_t max_subscribers;           /* Capacity of the subscriber table */
+    sc_subscriber_index_t dispatch_heads[SAFECORE_MAX_EVENT_TYPES]; /* First subscriber per event ID */
+    sc_subscriber_index_t dispatch_tails[SAFECORE_MAX_EVENT_TYPES]; /* Last subscriber per event ID */
+    sc_queue_t *queues;                 /* One queue per priority level */
+    uint8_t priorities;                 /* Number of priority levels */
+    uint8_t peek_level;                 /* Level of the event held by sc_bus_peek() */
+#if SAFECORE_MPSC_ENABLED == 1
+    _Atomic sc_prio_mask_t ready;       /* Bit set per level that may hold events */
+#else
+    sc_prio_mask_t ready;               /* Bit set per level that may hold events */
+#endif
+#if SAFECORE_FILTERS_ENABLED == 1
+    sc_filter_set_t filters;            /* Filter rules of this instance */
+#endif
+#if SAFECORE_PRIORITY_ENABLED == 1
+    sc_bus_sched_t sched;               /* Scheduling state of the priority levels */
+#endif
+#if SAFECORE_COALESCE_ENABLED == 1
+    sc_bus_pending_t pending[SAFECORE_MAX_EVENT_TYPES]; /* Last-value slot per event ID */
+#endif
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+    sc_bus_hist_t hist;                 /* Latency and depth histograms */
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+    sc_bus_backpressure_t bp;           /* Watermarks and congestion state */
+#endif
+#if SAFECORE_SPILL_ENABLED == 1
+    sc_spill_t spill;                   /* Overflow file of the low priority levels */
+#endif
+#if SAFECORE_WAIT_ENABLED == 1
+    _Atomic uint32_t wake_seq;          /* Futex word, bumped to wake waiters */
+    _Atomic uint32_t waiters;           /* Threads blocked in sc_bus_wait() */
+#endif
+#if SAFECORE_PROCESS_BUDGET_ENABLED == 1
+    uint8_t resume_level;               /* Level a budgeted processing call resumes at */
+    uint16_t resume_count;              /* Events already delivered from that level this cycle */
+#endif
+} sc_bus_t;
+
+/* === Batch Publish Status === */
+#define SC_PUBLISH_OK                   0    /* Event queued */
+#define SC_PUBLISH_FILTERED             1    /* Event rejected by a filter rule */
+#define SC_PUBLISH_INVALID              (-1) /* Invalid event (NULL, empty or bad ID) */
+#define SC_PUBLISH_DROPPED              (-2) /* Queue full, event dropped */
+#define SC_PUBLISH_CONGESTED            2    /* Event queued, level at or above its high watermark */
+#define SC_PUBLISH_FULL                 (-3) /* Queue full, event not queued (try publish) */
+
+/* Timeout of sc_bus_wait() that never expires */
+#define SC_WAIT_FOREVER                 0xFFFFFFFFU
+
+/* === Bus Storage Size Calculation === */
+#define SC_BUS_ALIGN                    8U
+#define SC_BUS_ALIGN_UP(n)              ((((size_t)(n)) + (SC_BUS_ALIGN - 1U)) & ~((size_t)SC_BUS_ALIGN - 1U))
+
+#if SAFECORE_MPSC_ENABLED == 1
+#define SC_BUS_SEQ_BYTES(slots)         SC_BUS_ALIGN_UP((size_t)(slots) * sizeof(sc_queue_seq_t))
+#else
+#define SC_BUS_SEQ_BYTES(slots)         ((size_t)0U)
+#endif
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+#define SC_BUS_LEVEL_BYTES(queue_size, event_size) \
+    SC_BUS_ALIGN_UP((size_t)(queue_size))
+#else
+#define SC_BUS_LEVEL_BYTES(queue_size, event_size) \
+    (SC_BUS_ALIGN_UP((size_t)(queue_size) * (event_size)) + \
+     SC_BUS_ALIGN_UP((size_t)(queue_size) * sizeof(uint16_t)) + \
+     SC_BUS_SEQ_BYTES(queue_size))
+#endif
+
+#define SC_BUS_QUEUE_BYTES(prios, queue_size, event_size) \
+    ((size_t)(prios) * SC_BUS_LEVEL_BYTES(queue_size, event_size))
+
+#if SAFECORE_FILTERS_ENABLED == 1
+#define SC_BUS_RULE_BYTES(rules)        SC_BUS_ALIGN_UP((size_t)(rules) * sizeof(sc_filter_rule_t))
+#else
+#define SC_BUS_RULE_BYTES(rules)        ((size_t)0U)
+#endif
+
+/**
+ * @brief Storage size in bytes of an event bus instance without its queues
+ * 
+ * With per-level sizes, the storage size is this plus SC_BUS_LEVEL_BYTES()
+ * of every level.
+ */
+#define SC_BUS_BASE_BYTES(subs, prios, rules) \
+    ((SC_BUS_ALIGN - 1U) + \
+     SC_BUS_ALIGN_UP((size_t)(subs) * sizeof(subscriber_entry_t)) + \
+     SC_BUS_ALIGN_UP((size_t)(prios) * sizeof(sc_queue_t)) + \
+     SC_BUS_RULE_BYTES(rules))
+
+/**
+ * @brief Storage size in bytes required by an event bus instance
+ * 
+ * Compile-time form of sc_bus_storage_size() for uniform levels, usable to
+ * size static buffers.
+ */
+#define SC_BUS_STORAGE_SIZE(subs, queue_size, event_size, prios, rules) \
+    (SC_BUS_BASE_BYTES(subs, prios, rules) + \
+     SC_BUS_QUEUE_BYTES(prios, queue_size, event_size))
+
+/**
+ * @brief Get the storage size required by an event bus instance
+ * 
+ * @param cfg Instance configuration
+ * @return size_t Number of bytes sc_bus_init() needs, 0 on invalid parameters
+ */
+size_t sc_bus_storage_size(const sc_bus_config_t *cfg);
+/**
+ * @brief Initialize an event bus instance
+ * 
+ * This function lays out the subscriber table, queues and filter rules of
+ * the instance in caller-provided memory and resets them.
+ * 
+ * @param bus Instance to initialize
+ * @param cfg Instance configuration
+ * @param storage Caller-provided memory, at least sc_bus_storage_size(cfg) bytes
+ * @param storage_size Size of the provided memory in bytes
+ * @return 0 on success, -1 on failure (invalid configuration or storage too small)
+ */
+int sc_bus_init(sc_bus_t *bus, const sc_bus_config_t *cfg, void *storage, size_t storage_size);
+/**
+ * @brief Subscribe to an event on an instance
+ * 
+ * @param bus Event bus instance
+ * @param event_id ID of the event to subscribe to
+ * @param callback Function to call when the event is published
+ * @param ctx Context pointer to pass to the callback
+ * @return 0 on success, -1 on failure (invalid parameters or no slots available)
+ */
+int sc_bus_subscribe(sc_bus_t *bus, uint8_t event_id, sc_subscriber_fn_t callback, void *ctx);
+#if SAFECORE_PARALLEL_ENABLED == 1
+/**
+ * @brief Subscribe to an event on an instance within an execution domain
+ * 
+ * With the worker pool running, callbacks of one domain run on one thread in
+ * event order; callbacks of different domains may run concurrently.
+ * sc_bus_subscribe() uses domain 0, which runs on the processing thread.
+ * 
+ * @param bus Event bus instance
+ * @param event_id ID of the event to subscribe to
+ * @param callback Function to call when the event is published
+ * @param ctx Context pointer to pass to the callback
+ * @param domain Execution domain
+ * @return 0 on success, -1 on failure (invalid parameters or no slots available)
+ */
+int sc_bus_subscribe_domain(sc_bus_t *bus, uint8_t event_id, sc_subscriber_fn_t callback,
+                            void *ctx, uint8_t domain);
+#endif
+/**
+ * @brief Publish an event with raw data on an instance
+ * 
+ * @param bus Event bus instance
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return 0 on success, -1 on failure (invalid parameters)
+ */
+int sc_bus_publish_raw(sc_bus_t *bus, const uint8_t *event_data, size_t size);
+/**
+ * @brief Copy a validated event into a priority level queue
+ * 
+ * Used by the publish paths after ID checks and filtering. Clears the
+ * bus-owned flags byte of the queued copy.
+ * 
+ * @param bus Event bus instance
+ * @param prio Priority level (must be below the instance's level count)
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int 0 on success, -1 on failure (invalid parameters or event dropped)
+ */
+int sc_bus_enqueue(sc_bus_t *bus, uint8_t prio, const uint8_t *event_data, size_t size);
+
+/**
+ * @brief Find the next priority level that may hold events
+ *
+ * Publishing sets the level's bit in the instance's ready bitmap, so the
+ * consumer finds the highest-priority non-empty level with one bit scan
+ * instead of polling every queue.
+ *
+ * @param bus Event bus instance
+ * @param from First level to consider
+ * @return uint8_t Lowest ready level at or after from, or the instance's level count if none
+ */
+uint8_t sc_bus_next_ready(const sc_bus_t *bus, uint8_t from);
+
+/**
+ * @brief Update the ready bit of a level after taking events from it
+ *
+ * Clears the bit when the level's queue is empty. Called by the consumer
+ * after sc_queue_release(); a concurrent publish re-sets the bit.
+ *
+ * @param bus Event bus instance
+ * @param level Priority level
+ */
+void sc_bus_ready_refresh(sc_bus_t *bus, uint8_t level);
+
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Publish an event on an instance unless its queue is full
+ * 
+ * Unlike sc_bus_publish_raw() it never applies the overflow policy: an
+ * event that does not fit is left with the caller. The result tells the
+ * producer to slow down once the level reaches its high watermark.
+ * 
+ * @param bus Event bus instance
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int SC_PUBLISH_OK, SC_PUBLISH_CONGESTED (queued, level congested),
+ *         SC_PUBLISH_FILTERED, SC_PUBLISH_FULL (not queued), SC_PUBLISH_DROPPED
+ *         (room taken by another producer) or SC_PUBLISH_INVALID
+ */
+int sc_bus_try_publish(sc_bus_t *bus, const uint8_t *event_data, size_t size);
+
+/**
+ * @brief Set the watermarks of a priority level
+ * 
+ * A level becomes congested when a publish leaves it with high or more
+ * events, and recovers once processing has brought it down to low or fewer.
+ * The defaults are SAFECORE_BACKPRESSURE_HIGH_PCT and
+ * SAFECORE_BACKPRESSURE_LOW_PCT of the level's capacity.
+ * 
+ * @param bus Event bus instance
+ * @param prio Priority level
+ * @param high High watermark in events (greater than low)
+ * @param low Low watermark in events
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_set_watermarks(sc_bus_t *bus, uint8_t prio, uint16_t high, uint16_t low);
+
+/**
+ * @brief Set the callback called on watermark crossings
+ * 
+ * @param bus Event bus instance
+ * @param callback Callback, or NULL to disable
+ * @param ctx Context pointer passed to the callback
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_set_backpressure_callback(sc_bus_t *bus, sc_backpressure_fn_t callback, void *ctx);
+
+/**
+ * @brief Get the congested priority levels of an instance
+ * 
+ * @param bus Event bus instance
+ * @return sc_prio_mask_t Bit set per congested level
+ */
+sc_prio_mask_t sc_bus_get_congestion(const sc_bus_t *bus);
+
+/**
+ * @brief Clear the congestion of levels that fell to their low watermark
+ * 
+ * Called by the processing paths after taking events; calls the
+ * callback for every level that recovered.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_backpressure_update(sc_bus_t *bus);
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+/**
+ * @brief Open the spill file of an instance
+ * 
+ * From then on, events of levels SAFECORE_SPILL_MIN_LEVEL and below that
+ * find their queue full are appended to the file instead of triggering the
+ * overflow policy. While the file holds events, all events of those levels
+ * go to the file, so none overtakes an older one; processing pages them
+ * back into the queues as these drain. Events smaller than sc_event_t
+ * never spill. The file is created or truncated.
+ * 
+ * @param bus Event bus instance
+ * @param path Path of the backing file
+ * @param bytes File size in bytes, a power of two of at least SC_SPILL_MIN_BYTES
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_spill_open(sc_bus_t *bus, const char *path, uint32_t bytes);
+
+/**
+ * @brief Close the spill file of an instance
+ * 
+ * Events still in the file are lost; the levels fall back to the overflow
+ * policy.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_spill_close(sc_bus_t *bus);
+
+/**
+ * @brief Get the number of events waiting in the spill file
+ * 
+ * @param bus Event bus instance
+ * @return uint32_t Number of spilled events not yet paged back
+ */
+uint32_t sc_bus_spill_pending(const sc_bus_t *bus);
+
+/**
+ * @brief Page spilled events back into their queues
+ * 
+ * Moves events in file order while their level has room and stops at the
+ * first one that does not fit. Called by the processing paths.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_spill_refill(sc_bus_t *bus);
+#endif
+
+#if SAFECORE_COALESCE_ENABLED == 1
+/**
+ * @brief Enable or disable last-value coalescing for an event ID
+ * 
+ * While an event of a coalescing ID waits in a queue, publishing the ID
+ * again overwrites the waiting event in place instead of queueing another
+ * one, so at most one event per coalescing ID is pending. Events already
+ * taken by the consumer are not touched. A publish with a different size or
+ * priority level queues a new event. Pool handle events are never coalesced.
+ * 
+ * @param bus Event bus instance
+ * @param event_id Event ID
+ * @param enable 1 to enable, 0 to disable
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_set_coalescing(sc_bus_t *bus, uint8_t event_id, uint8_t enable);
+#endif
+
+/**
+ * @brief Publish an array of events on an instance
+ * 
+ * Validates and filters every event once, then copies the events of each
+ * priority level into its queue and publishes them with a single head update
+ * per level. Events of one level keep their array order.
+ * 
+ * @param bus Event bus instance
+ * @param events Array of n pointers to event data
+ * @param sizes Array of n event sizes in bytes
+ * @param n Number of events
+ * @param status Array of n entries to receive an SC_PUBLISH_* code per event (may be NULL)
+ * @return int Number of queued events, -1 on invalid parameters
+ */
+int sc_bus_publish_batch(sc_bus_t *bus, const uint8_t *const events[], const size_t sizes[],
+                         size_t n, int8_t status[]);
+
+#if SAFECORE_PROCESS_BATCH_ENABLED == 1
+/**
+ * @brief Process pending events of an instance in batches
+ * 
+ * Takes up to max_per_level events from each priority level, highest first,
+ * and delivers them grouped by event ID: each subscriber of an ID receives
+ * all of that ID's events in a row before the next subscriber runs. Events
+ * of one ID keep their queue order; events of different IDs do not. Only
+ * available with SAFECORE_SCHED_STRICT, as the levels are drained in fixed
+ * priority order.
+ * 
+ * @param bus Event bus instance
+ * @param max_per_level Events per level, 0 or more than SAFECORE_BATCH_MAX_EVENTS means SAFECORE_BATCH_MAX_EVENTS
+ */
+void sc_bus_process_batch(sc_bus_t *bus, uint16_t max_per_level);
+#endif
+
+/**
+ * @brief Process pending events of an instance
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_process(sc_bus_t *bus);
+
+#if SAFECORE_WAIT_ENABLED == 1
+/**
+ * @brief Block until events are pending on an instance
+ * 
+ * Returns immediately if an event is queued. Otherwise the calling thread
+ * sleeps on a futex until a producer publishes or the timeout expires.
+ * Producers only enter the kernel while a thread is waiting.
+ * 
+ * @param bus Event bus instance
+ * @param timeout_ms Timeout in milliseconds, SC_WAIT_FOREVER to wait without limit
+ * @return int 1 if events are pending, 0 on timeout, -1 on invalid parameters
+ */
+int sc_bus_wait(sc_bus_t *bus, uint32_t timeout_ms);
+#endif
+
+#if SAFECORE_PROCESS_BUDGET_ENABLED == 1
+/**
+ * @brief Process pending events of an instance within a time budget
+ * 
+ * Delivers events in the same order as sc_bus_process(), at most
+ * SAFECORE_MAX_EVENTS_PER_CYCLE per priority level and cycle, and checks
+ * safecore_get_tick_us() before each queue access. When the budget is used
+ * up it returns; the next call resumes at the same level with the rest of
+ * that level's quota. At least one ready event is delivered per call, and
+ * no timeout error is raised. A cycle over all levels that delivers nothing
+ * ends the call, so MPSC slots a producer has reserved but not yet filled
+ * are left for the next call. With SAFECORE_SCHED_EDF events are delivered by
+ * earliest deadline instead. Not available with the other policies.
+ * 
+ * @param bus Event bus instance
+ * @param budget_us Time budget in microseconds
+ * @param remaining Pointer to store the number of events still pending (may be NULL)
+ * @return uint32_t Number of events delivered
+ */
+uint32_t sc_bus_process_budget(sc_bus_t *bus, uint32_t budget_us, uint32_t *remaining);
+#endif
+/**
+ * @brief Deliver an event to the subscribers of an instance
+ * 
+ * Only the subscribers of the event's ID are visited.
+ * 
+ * @param bus Event bus instance
+ * @param e Pointer to the event to deliver
+ */
+void sc_bus_dispatch(const sc_bus_t *bus, const sc_event_t *e);
+
+/**
+ * @brief Deliver an event taken from a priority level queue
+ * 
+ * Used by the processing paths instead of sc_bus_dispatch(). With
+ * SAFECORE_HISTOGRAM_ENABLED it records the event's queue wait, callback
+ * time and level depth in the instance's histograms.
+ * 
+ * @param bus Event bus instance
+ * @param level Priority level the event was taken from
+ * @param e Pointer to the event to deliver
+ */
+void sc_bus_deliver(sc_bus_t *bus, uint8_t level, const sc_event_t *e);
+/**
+ * @brief Deliver the event held by sc_bus_peek(), if any
+ * 
+ * Called first by every processing path, so an event the application was
+ * shown by sc_bus_peek() is delivered ahead of all others and never lost.
+ * 
+ * @param bus Event bus instance
+ * @return uint32_t Number of events delivered (0 or 1)
+ */
+uint32_t sc_bus_deliver_held(sc_bus_t *bus);
+
+/**
+ * @brief Reserve a queue slot to build an event in place
+ * 
+ * Returns a pointer into a free slot of the given priority level. The caller
+ * fills in the event, including its sc_event_t header, and publishes it with
+ * sc_bus_commit(). This avoids building the event on the stack and copying it
+ * into the queue.
+ * 
+ * @param bus Event bus instance
+ * @param prio Priority level (ignored without priority support)
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure (invalid parameters, queue full
+ *         or, for a spilling level, events waiting in the spill file)
+ */
+uint8_t* sc_bus_reserve(sc_bus_t *bus, uint8_t prio, size_t size);
+/**
+ * @brief Publish an event built in a reserved slot
+ * 
+ * Validates and filters the event. A rejected event is discarded and never
+ * delivered. The priority field is set to the reserved level.
+ * 
+ * @param bus Event bus instance
+ * @param event Pointer returned by sc_bus_reserve()
+ * @return 0 on success (including filtered events), -1 on failure
+ */
+int sc_bus_commit(sc_bus_t *bus, uint8_t *event);
+
+#if SAFECORE_POOL_ENABLED == 1
+/**
+ * @brief Publish a pool payload as a handle event
+ * 
+ * Queues only the payload's handle (see safecore_pool.h). The caller's
+ * reference moves to the event and is dropped once the event has been
+ * delivered, evicted or filtered; subscribers keep the payload beyond their
+ * callback with sc_pool_retain().
+ * 
+ * @param bus Event bus instance
+ * @param id Event ID
+ * @param prio Priority level (ignored without priority support)
+ * @param payload Pointer returned by sc_pool_alloc()
+ * @return int 0 on success (including filtered events), -1 on failure
+ */
+int sc_bus_publish_pooled(sc_bus_t *bus, uint8_t id, uint8_t prio, void *payload);
+#endif
+/**
+ * @brief Look at the next pending event in place
+ * 
+ * Returns the oldest event of the highest non-empty priority level without
+ * removing it. The slot cannot be overwritten by producers until
+ * sc_bus_release() is called. If the bus is processed instead, the held
+ * event is delivered ahead of all other events.
+ * 
+ * @param bus Event bus instance
+ * @param out_size Pointer to store the size of the event (may be NULL)
+ * @return const sc_event_t* Pointer to the event, or NULL if no event is pending
+ */
+const sc_event_t* sc_bus_peek(sc_bus_t *bus, size_t *out_size);
+/**
+ * @brief Remove the event returned by sc_bus_peek()
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_release(sc_bus_t *bus);
+
+/**
+ * @brief Get the default event bus instance
+ * 
+ * The sc_eventbus_* functions operate on this instance, whose storage is
+ * sized by the SAFECORE_* configuration macros.
+ * 
+ * @return sc_bus_t* Pointer to the default instance
+ */
+sc_bus_t* sc_eventbus_default(void);
 /**
  * @brief Initialize the event bus
  * 
@@ -119,6 +765,19 @@ void sc_eventbus_init(void);
  * @return 0 on success, -1 on failure (invalid parameters or no slots available)
  */
 int sc_eventbus_subscribe(uint8_t event_id, sc_subscriber_fn_t callback, void *ctx);
+#if SAFECORE_PARALLEL_ENABLED == 1
+/**
+ * @brief Subscribe to an event within an execution domain
+ * 
+ * @param event_id ID of the event to subscribe to
+ * @param callback Function to call when the event is published
+ * @param ctx Context pointer to pass to the callback
+ * @param domain Execution domain
+ * @return 0 on success, -1 on failure
+ */
+int sc_eventbus_subscribe_domain(uint8_t event_id, sc_subscriber_fn_t callback, void *ctx,
+                                 uint8_t domain);
+#endif
 /**
  * @brief Publish an event with raw data
  * 
@@ -130,13 +789,182 @@ int sc_eventbus_subscribe(uint8_t event_id, sc_subscriber_fn_t callback, void *c
  * @return 0 on success, -1 on failure (invalid parameters)
  */
 int sc_eventbus_publish_raw(const uint8_t *event_data, size_t size);
+#if SAFECORE_COALESCE_ENABLED == 1
+/**
+ * @brief Enable or disable last-value coalescing for an event ID
+ * 
+ * @param event_id Event ID
+ * @param enable 1 to enable, 0 to disable
+ * @return 0 on success, -1 on invalid parameters
+ */
+int sc_eventbus_set_coalescing(uint8_t event_id, uint8_t enable);
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+/**
+ * @brief Publish an event unless its queue is full
+ * 
+ * @param event_data Pointer to the event data
+ * @param size Size of the event data in bytes
+ * @return int SC_PUBLISH_* code, see sc_bus_try_publish()
+ */
+int sc_eventbus_try_publish(const uint8_t *event_data, size_t size);
+/**
+ * @brief Set the watermarks of a priority level
+ * 
+ * @param prio Priority level
+ * @param high High watermark in events (greater than low)
+ * @param low Low watermark in events
+ * @return 0 on success, -1 on invalid parameters
+ */
+int sc_eventbus_set_watermarks(uint8_t prio, uint16_t high, uint16_t low);
+/**
+ * @brief Set the callback called on watermark crossings
+ * 
+ * @param callback Callback, or NULL to disable
+ * @param ctx Context pointer passed to the callback
+ * @return 0 on success, -1 on invalid parameters
+ */
+int sc_eventbus_set_backpressure_callback(sc_backpressure_fn_t callback, void *ctx);
+/**
+ * @brief Get the congested priority levels
+ * 
+ * @return sc_prio_mask_t Bit set per congested level
+ */
+sc_prio_mask_t sc_eventbus_get_congestion(void);
+#endif
+#if SAFECORE_SPILL_ENABLED == 1
+/**
+ * @brief Open the spill file of the low priority levels
+ * 
+ * @param path Path of the backing file
+ * @param bytes File size in bytes, a power of two of at least SC_SPILL_MIN_BYTES
+ * @return 0 on success, -1 on failure
+ */
+int sc_eventbus_spill_open(const char *path, uint32_t bytes);
+/**
+ * @brief Close the spill file, losing the events still in it
+ */
+void sc_eventbus_spill_close(void);
+/**
+ * @brief Get the number of events waiting in the spill file
+ * 
+ * @return uint32_t Number of spilled events not yet paged back
+ */
+uint32_t sc_eventbus_spill_pending(void);
+#endif
+/**
+ * @brief Publish an array of events
+ * 
+ * @param events Array of n pointers to event data
+ * @param sizes Array of n event sizes in bytes
+ * @param n Number of events
+ * @param status Array of n entries to receive an SC_PUBLISH_* code per event (may be NULL)
+ * @return Number of queued events, -1 on invalid parameters
+ */
+int sc_eventbus_publish_batch(const uint8_t *const events[], const size_t sizes[], size_t n,
+                              int8_t status[]);
+#if SAFECORE_PROCESS_BATCH_ENABLED == 1
+/**
+ * @brief Process events in batches grouped by event ID
+ * 
+ * @param max_per_level Maximum events per priority level
+ */
+void sc_eventbus_process_batch(uint16_t max_per_level);
+#endif
 /**
  * @brief Process events in the event bus
  * 
  * This function processes all pending events in the event bus, delivering
- * them to all matching subscribers. It also performs timeout checks.
+ * them to all matching subscribers. It also performs timeout checks and,
+ * with SAFECORE_TIMER_ENABLED, first publishes expired timers.
  */
 void sc_eventbus_process(void);
+#if SAFECORE_WAIT_ENABLED == 1
+/**
+ * @brief Block until there is work for sc_eventbus_process()
+ * 
+ * Like sc_bus_wait() on the default instance; with SAFECORE_TIMER_ENABLED
+ * the sleep also ends when the next timer is due. Call
+ * sc_eventbus_process() after it returns in either case.
+ * 
+ * @param timeout_ms Timeout in milliseconds, SC_WAIT_FOREVER to wait without limit
+ * @return int 1 if events are pending, 0 otherwise
+ */
+int sc_eventbus_wait(uint32_t timeout_ms);
+#endif
+#if SAFECORE_PROCESS_BUDGET_ENABLED == 1
+/**
+ * @brief Process events within a time budget
+ * 
+ * Publishes expired timers like sc_eventbus_process(), then delivers events
+ * until the queues are empty or the budget is used up. A burst is spread
+ * over several calls instead of triggering the processing timeout.
+ * 
+ * @param budget_us Time budget in microseconds
+ * @param remaining Pointer to store the number of events still pending (may be NULL)
+ * @return Number of events delivered
+ */
+uint32_t sc_eventbus_process_budget(uint32_t budget_us, uint32_t *remaining);
+#endif
+/**
+ * @brief Deliver an event to its subscribers
+ * 
+ * This function delivers a single event to every subscriber registered for
+ * its event ID, in subscription order. Only the subscribers of that event ID
+ * are visited, so the cost does not depend on the total subscriber count.
+ * 
+ * @param e Pointer to the event to deliver
+ */
+void sc_eventbus_dispatch(const sc_event_t *e);
+/**
+ * @brief Reserve a queue slot to build an event in place
+ * 
+ * @param prio Priority level (ignored without priority support)
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure
+ */
+uint8_t* sc_eventbus_reserve(uint8_t prio, size_t size);
+/**
+ * @brief Publish an event built in a reserved slot
+ * 
+ * @param event Pointer returned by sc_eventbus_reserve()
+ * @return 0 on success (including filtered events), -1 on failure
+ */
+int sc_eventbus_commit(uint8_t *event);
+#if SAFECORE_POOL_ENABLED == 1
+/**
+ * @brief Publish a pool payload as a handle event
+ * 
+ * @param id Event ID
+ * @param prio Priority level (ignored without priority support)
+ * @param payload Pointer returned by sc_pool_alloc()
+ * @return 0 on success (including filtered events), -1 on failure
+ */
+int sc_eventbus_publish_pooled(uint8_t id, uint8_t prio, void *payload);
+#endif
+/**
+ * @brief Look at the next pending event in place
+ * 
+ * @param out_size Pointer to store the size of the event (may be NULL)
+ * @return const sc_event_t* Pointer to the event, or NULL if no event is pending
+ */
+const sc_event_t* sc_eventbus_peek(size_t *out_size);
+/**
+ * @brief Remove the event returned by sc_eventbus_peek()
+ */
+void sc_eventbus_release(void);
+
+/**
+ * @brief Reserve a typed event in a queue slot
+ * 
+ * Reserves a slot sized for the event type and returns it as a typed pointer,
+ * or NULL. Publish it with sc_eventbus_commit().
+ * 
+ * @param type Event structure type (must start with sc_event_t)
+ * @param prio Priority level
+ */
+#define SC_RESERVE_EVENT(type, prio) \
+    ((type *)(void *)sc_eventbus_reserve((prio), sizeof(type)))
 
 /**
  * @brief Compile-time checked event publish macro
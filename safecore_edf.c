@@ -0,0 +1,229 @@
+/*
+ * safecore_edf.c
+ *
+ * SafeCore Deadline Queue Implementation
+ * This file implements the bounded earliest-deadline-first queue used by
+ * the priority module: a 4-ary min-heap of small entries over fixed event
+ * slots.
+ */
+#include "safecore_edf.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+
+/**
+ * @brief Check whether an entry is due before another
+ *
+ * @param a First entry
+ * @param b Second entry
+ * @return int 1 if a has the earlier deadline, or the same deadline and arrived first
+ */
+SAFECORE_INLINE int edf_before(const sc_edf_entry_t *a, const sc_edf_entry_t *b) {
+    int32_t diff = (int32_t)(a->deadline - b->deadline);
+
+    if (diff == 0) {
+        diff = (int32_t)(a->seq - b->seq);
+    }
+
+    return (diff < 0) ? 1 : 0;
+}
+
+/**
+ * @brief Move an entry up until its parent is due first
+ *
+ * @param edf Deadline queue
+ * @param pos Heap position of the entry
+ */
+static void edf_sift_up(sc_edf_t *edf, uint16_t pos) {
+    sc_edf_entry_t entry = edf->heap[pos];
+
+    while (pos > 0U) {
+        uint16_t parent = (uint16_t)((pos - 1U) / SC_EDF_ARITY);
+        if (edf_before(&entry, &edf->heap[parent]) == 0) {
+            break;
+        }
+        edf->heap[pos] = edf->heap[parent];
+        pos = parent;
+    }
+
+    edf->heap[pos] = entry;
+}
+
+/**
+ * @brief Move an entry down until no child is due first
+ *
+ * @param edf Deadline queue
+ * @param pos Heap position of the entry
+ */
+static void edf_sift_down(sc_edf_t *edf, uint16_t pos) {
+    sc_edf_entry_t entry = edf->heap[pos];
+
+    for (;;) {
+        uint32_t first = ((uint32_t)pos * SC_EDF_ARITY) + 1U;
+        uint32_t last = first + SC_EDF_ARITY;
+        uint32_t best;
+        uint32_t child;
+
+        if (first >= edf->count) {
+            break;
+        }
+        if (last > edf->count) {
+            last = edf->count;
+        }
+
+        /* Earliest of up to SC_EDF_ARITY children */
+        best = first;
+        for (child = first + 1U; child < last; child++) {
+            if (edf_before(&edf->heap[child], &edf->heap[best]) != 0) {
+                best = child;
+            }
+        }
+
+        if (edf_before(&edf->heap[best], &entry) == 0) {
+            break;
+        }
+        edf->heap[pos] = edf->heap[best];
+        pos = (uint16_t)best;
+    }
+
+    edf->heap[pos] = entry;
+}
+
+/**
+ * @brief Initialize a deadline queue to the empty state
+ *
+ * @param edf Queue to initialize
+ */
+void sc_edf_init(sc_edf_t *edf) {
+    uint16_t i;
+
+    if (edf == NULL) {
+        return;
+    }
+
+    (void)memset(edf, 0, sizeof(*edf));
+    for (i = 0U; i < (uint16_t)SAFECORE_EDF_QUEUE_SIZE; i++) {
+        edf->free_slots[i] = i;
+    }
+}
+
+/**
+ * @brief Copy an event into the deadline queue
+ *
+ * @param edf Queue to push to
+ * @param data Pointer to the event data to copy
+ * @param size Size of the event data in bytes
+ * @param deadline Absolute deadline in milliseconds
+ * @param level Priority level the event was published at
+ * @return int 0 on success, -1 on failure
+ */
+int sc_edf_push(sc_edf_t *edf, const uint8_t *data, size_t size, uint32_t deadline, uint8_t level) {
+    if ((edf == NULL) || (data == NULL) || (size == 0U) || (size > SAFECORE_MAX_EVENT_SIZE) ||
+        (edf->count >= (uint16_t)SAFECORE_EDF_QUEUE_SIZE)) {
+        return -1;
+    }
+
+    /* Take the last unused slot */
+    uint16_t slot = edf->free_slots[(uint16_t)SAFECORE_EDF_QUEUE_SIZE - edf->count - 1U];
+    (void)memcpy(edf->slots[slot], data, size);
+    edf->sizes[slot] = (uint16_t)size;
+
+    uint16_t pos = edf->count;
+    edf->heap[pos].deadline = deadline;
+    edf->heap[pos].seq = edf->seq;
+    edf->heap[pos].slot = slot;
+    edf->heap[pos].level = level;
+    edf->seq++;
+    edf->count++;
+    edf_sift_up(edf, pos);
+
+    return 0;
+}
+
+/**
+ * @brief Look at the event with the earliest deadline
+ *
+ * @param edf Queue to peek at
+ * @param out_size Pointer to store the size of the event (may be NULL)
+ * @param deadline Pointer to store the deadline of the event (may be NULL)
+ * @param level Pointer to store the priority level of the event (may be NULL)
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_edf_peek(const sc_edf_t *edf, size_t *out_size, uint32_t *deadline,
+                           uint8_t *level) {
+    if ((edf == NULL) || (edf->count == 0U)) {
+        return NULL;
+    }
+
+    const sc_edf_entry_t *top = &edf->heap[0];
+    if (out_size != NULL) {
+        *out_size = edf->sizes[top->slot];
+    }
+    if (deadline != NULL) {
+        *deadline = top->deadline;
+    }
+    if (level != NULL) {
+        *level = top->level;
+    }
+
+    return (const uint8_t *)(const void *)edf->slots[top->slot];
+}
+
+/**
+ * @brief Remove the event with the earliest deadline
+ *
+ * Returns the event's slot to the unused slots and moves the last heap
+ * entry down from the root.
+ *
+ * @param edf Queue to pop from
+ */
+void sc_edf_pop(sc_edf_t *edf) {
+    if ((edf == NULL) || (edf->count == 0U)) {
+        return;
+    }
+
+    edf->free_slots[(uint16_t)SAFECORE_EDF_QUEUE_SIZE - edf->count] = edf->heap[0].slot;
+    edf->count--;
+
+    if (edf->count > 0U) {
+        edf->heap[0] = edf->heap[edf->count];
+        edf_sift_down(edf, 0U);
+    }
+}
+
+/**
+ * @brief Get the number of events in the deadline queue
+ *
+ * @param edf Queue to query
+ * @return uint16_t Number of queued events
+ */
+uint16_t sc_edf_count(const sc_edf_t *edf) {
+    return (edf != NULL) ? edf->count : 0U;
+}
+
+/**
+ * @brief Get the number of queued events of one priority level
+ *
+ * Scans the heap entries, for statistics only.
+ *
+ * @param edf Queue to query
+ * @param level Priority level
+ * @return uint16_t Number of queued events published at the level
+ */
+uint16_t sc_edf_level_count(const sc_edf_t *edf, uint8_t level) {
+    uint16_t n = 0U;
+    uint16_t i;
+
+    if (edf != NULL) {
+        for (i = 0U; i < edf->count; i++) {
+            if (edf->heap[i].level == level) {
+                n++;
+            }
+        }
+    }
+
+    return n;
+}
+
+#endif /* SAFECORE_PRIORITY_ENABLED && SAFECORE_SCHED_EDF */
@@ -0,0 +1,115 @@
+/*
+ * safecore_edf.h
+ *
+ * SafeCore Deadline Queue Interface
+ * This file defines the bounded earliest-deadline-first queue used by the
+ * priority module when SAFECORE_SCHED_POLICY is SAFECORE_SCHED_EDF. Events
+ * are copied into fixed slots and ordered by a 4-ary min-heap on their
+ * absolute deadline; events with equal deadlines keep their arrival order.
+ *
+ * The queue belongs to the consumer. Producers keep publishing into the
+ * priority level rings, and processing moves events from the rings into
+ * the deadline queue, so no producer ever touches the heap.
+ */
+#ifndef SAFECORE_EDF_H
+#define SAFECORE_EDF_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include <stddef.h>
+
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+
+#define SC_EDF_ARITY                4U  /* Children per heap node */
+#define SC_EDF_SLOT_WORDS           (((size_t)SAFECORE_MAX_EVENT_SIZE + 7U) / 8U)
+
+/**
+ * @brief Heap entry of a queued event
+ */
+typedef struct {
+    uint32_t deadline;              /* Absolute deadline in milliseconds */
+    uint32_t seq;                   /* Arrival number, orders equal deadlines */
+    uint16_t slot;                  /* Slot holding the event */
+    uint8_t level;                  /* Priority level the event was published at */
+} sc_edf_entry_t;
+
+/**
+ * @brief Bounded deadline queue
+ *
+ * Holds up to SAFECORE_EDF_QUEUE_SIZE events of up to SAFECORE_MAX_EVENT_SIZE
+ * bytes. Only the small heap entries move when the order changes; events
+ * stay in their slot until removed.
+ */
+typedef struct {
+    sc_edf_entry_t heap[SAFECORE_EDF_QUEUE_SIZE];               /* Min-heap on deadline */
+    uint64_t slots[SAFECORE_EDF_QUEUE_SIZE][SC_EDF_SLOT_WORDS]; /* Event storage */
+    uint16_t sizes[SAFECORE_EDF_QUEUE_SIZE];                    /* Size of the event in each slot */
+    uint16_t free_slots[SAFECORE_EDF_QUEUE_SIZE];               /* Unused slots, the first
+                                                                   capacity - count entries */
+    uint16_t count;                                             /* Number of queued events */
+    uint32_t seq;                                               /* Next arrival number */
+} sc_edf_t;
+
+/**
+ * @brief Initialize a deadline queue to the empty state
+ *
+ * @param edf Queue to initialize
+ */
+void sc_edf_init(sc_edf_t *edf);
+
+/**
+ * @brief Copy an event into the deadline queue
+ *
+ * Deadlines are compared modulo 2^32, so they may wrap as long as queued
+ * deadlines lie within 2^31 milliseconds of each other.
+ *
+ * @param edf Queue to push to
+ * @param data Pointer to the event data to copy
+ * @param size Size of the event data in bytes
+ * @param deadline Absolute deadline in milliseconds
+ * @param level Priority level the event was published at
+ * @return int 0 on success, -1 on failure (invalid parameters or queue full)
+ */
+int sc_edf_push(sc_edf_t *edf, const uint8_t *data, size_t size, uint32_t deadline, uint8_t level);
+
+/**
+ * @brief Look at the event with the earliest deadline
+ *
+ * The event stays in its slot until sc_edf_pop(), so it may be delivered
+ * in place.
+ *
+ * @param edf Queue to peek at
+ * @param out_size Pointer to store the size of the event (may be NULL)
+ * @param deadline Pointer to store the deadline of the event (may be NULL)
+ * @param level Pointer to store the priority level of the event (may be NULL)
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_edf_peek(const sc_edf_t *edf, size_t *out_size, uint32_t *deadline,
+                           uint8_t *level);
+
+/**
+ * @brief Remove the event with the earliest deadline
+ *
+ * @param edf Queue to pop from
+ */
+void sc_edf_pop(sc_edf_t *edf);
+
+/**
+ * @brief Get the number of events in the deadline queue
+ *
+ * @param edf Queue to query
+ * @return uint16_t Number of queued events
+ */
+uint16_t sc_edf_count(const sc_edf_t *edf);
+
+/**
+ * @brief Get the number of queued events of one priority level
+ *
+ * @param edf Queue to query
+ * @param level Priority level
+ * @return uint16_t Number of queued events published at the level
+ */
+uint16_t sc_edf_level_count(const sc_edf_t *edf, uint8_t level);
+
+#endif /* SAFECORE_PRIORITY_ENABLED && SAFECORE_SCHED_EDF */
+#endif /* SAFECORE_EDF_H */
@@ -6,52 +6,423 @@
  * events to be processed based on configurable rules.
  */
 #include "safecore_filters.h"
+#include "safecore_port.h"
 #include "safecore_config.h"
 #include <string.h>
 
 #if SAFECORE_FILTERS_ENABLED == 1
 
+#if SAFECORE_FILTER_FILE_ENABLED == 1
+#include <stdio.h>
+#include <sys/stat.h>
+#endif
+
+#define SC_FILTER_UNDECIDED         0xFFU   /* Decision not yet set while compiling */
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+#define SC_FILTER_TYPE_LAST         SC_FILTER_TYPE_BURST
+#elif SAFECORE_FILTER_VM_ENABLED == 1
+#define SC_FILTER_TYPE_LAST         SC_FILTER_TYPE_PROGRAM
+#else
+#define SC_FILTER_TYPE_LAST         SC_FILTER_TYPE_PRIORITY
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+#define SC_FILTER_TOKENS_PER_EVENT  1000U   /* Bucket tokens per event: one per millisecond at one event per second */
+#define SC_FILTER_REFILL_MAX_MS     256000U /* Refill time that fills any bucket (255 events at 1 per second) */
+#endif
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+/* A summary event must fit a queue slot of the default bus */
+SC_STATIC_ASSERT(sizeof(sc_filter_rate_event_t) <= SAFECORE_MAX_EVENT_SIZE,
+                 safecore_filter_rate_event_must_fit_event_size);
+#endif
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
 /**
- * @brief Global filter rules array
+ * @brief Get the program slots that programs are loaded into
  * 
- * Stores all configured filter rules for event processing
+ * @param set Filter rule set
+ * @return sc_fvm_program_t* Slots of the next table with table swapping, of the only table otherwise
  */
-static sc_filter_rule_t g_rules[SAFECORE_MAX_FILTER_RULES];
+static sc_fvm_program_t* filters_slots(sc_filter_set_t *set) {
+#if SAFECORE_FILTER_SWAP_ENABLED == 1
+    return set->programs;
+#else
+    return set->table.programs;
+#endif
+}
 
 /**
- * @brief Current number of active filter rules
+ * @brief Get the program a program rule runs
+ * 
+ * @param set Filter rule set
+ * @param rule Program rule
+ * @return sc_fvm_program_t* Loaded program, or NULL if the slot is invalid or empty
  */
-static uint8_t g_rule_count = 0;
+static sc_fvm_program_t* filters_rule_program(sc_filter_set_t *set, const sc_filter_rule_t *rule) {
+    sc_fvm_program_t *slots = filters_slots(set);
+
+    if ((rule->param >= SAFECORE_FILTER_PROGRAMS) || (slots[rule->param].len == 0U)) {
+        return NULL;
+    }
+
+    return &slots[rule->param];
+}
+#endif
 
 /**
- * @brief Initialize the event filtering system
+ * @brief Enter the filter table for one check
+ * 
+ * With table swapping, counts the caller in as a reader of the active
+ * table. The active pointer is read again after counting in: if it moved,
+ * the writer may already be rebuilding the table, so the caller moves on
+ * to the new one.
  * 
- * This function initializes the filter system by clearing all rules
- * and resetting the rule counter to zero.
+ * @param set Filter rule set
+ * @return sc_filter_table_t* Table to read until filters_release()
  */
-void sc_filters_init(void) {
+static sc_filter_table_t* filters_acquire(sc_filter_set_t *set) {
+#if SAFECORE_FILTER_SWAP_ENABLED == 1
+    for (;;) {
+        sc_filter_table_t *t = atomic_load(&set->active);
+        size_t idx = (size_t)(t - set->tables);
+
+        (void)atomic_fetch_add(&set->readers[idx], 1U);
+        if (atomic_load(&set->active) == t) {
+            return t;
+        }
+        (void)atomic_fetch_sub(&set->readers[idx], 1U);
+    }
+#else
+    return &set->table;
+#endif
+}
+
+/**
+ * @brief Leave the table entered with filters_acquire()
+ * 
+ * @param set Filter rule set
+ * @param t Table returned by filters_acquire()
+ */
+static void filters_release(sc_filter_set_t *set, const sc_filter_table_t *t) {
+#if SAFECORE_FILTER_SWAP_ENABLED == 1
+    (void)atomic_fetch_sub(&set->readers[(size_t)(t - set->tables)], 1U);
+#else
+    (void)set;
+    (void)t;
+#endif
+}
+
+#if SAFECORE_FILTER_SWAP_ENABLED != 1
+/**
+ * @brief Check an event against the rules one by one
+ * 
+ * Reference semantics of the filters: every enabled rule whose condition
+ * matches sets the result, so the last matching rule wins. Used for event
+ * IDs outside the decision table, which have no rate limit buckets.
+ * 
+ * @param set Filter rule set
+ * @param e Pointer to the event to check
+ * @param size Length of the event data in bytes
+ * @return int 1 if the event passes, 0 otherwise
+ */
+static int filters_walk(sc_filter_set_t *set, const sc_event_t *e, size_t size) {
+    int result = 1; /* Default to allowing events (whitelist mode) */
+    uint8_t i;
+
+#if SAFECORE_FILTER_VM_ENABLED != 1
+    (void)size; /* Only filter programs read the event data */
+#endif
+
+    /* Check event against all active rules */
+    for (i = 0U; i < set->count; i++) {
+        const sc_filter_rule_t *rule = &set->rules[i];
+
+        if (rule->enabled != 0U) {
+            switch (rule->type) {
+                case SC_FILTER_TYPE_ALLOW:
+                    if (e->id == rule->event_id) {
+                        result = 1; /* Allow the event */
+                    }
+                    break;
+                case SC_FILTER_TYPE_DENY:
+                    if (e->id == rule->event_id) {
+                        result = 0; /* Deny the event */
+                    }
+                    break;
+                case SC_FILTER_TYPE_SIZE_MIN:
+                    if (e->size < rule->param) {
+                        result = 0; /* Size too small */
+                    }
+                    break;
+                case SC_FILTER_TYPE_SIZE_MAX:
+                    if (e->size > rule->param) {
+                        result = 0; /* Size too large */
+                    }
+                    break;
+#if SAFECORE_PRIORITY_ENABLED == 1
+                case SC_FILTER_TYPE_PRIORITY:
+                    if (e->priority > rule->param) {
+                        result = 0; /* Priority too low */
+                    }
+                    break;
+#endif
+#if SAFECORE_FILTER_VM_ENABLED == 1
+                case SC_FILTER_TYPE_PROGRAM: {
+                    sc_fvm_program_t *prog = filters_rule_program(set, rule);
+                    if ((e->id == rule->event_id) && (prog != NULL) && (sc_fvm_run(prog, e, size) == 0U)) {
+                        result = 0; /* Rejected by the program */
+                    }
+                    break;
+                }
+#endif
+                default:
+                    /* Unknown rule type, maintain current behavior */
+                    break;
+            }
+        }
+    }
+
+    return result;
+}
+#endif
+
+/**
+ * @brief Compile the rules of a set into a decision table
+ * 
+ * Walks the rules backwards once. Size and priority rules apply to every
+ * ID and can only reject, so they narrow running bounds. The last allow or
+ * deny rule of an ID overrides everything before it: the ID's decision is
+ * that rule's result with the bounds of the rules after it. IDs without
+ * such a rule start from allow with the bounds of all rules. Program rules
+ * only reject too; those after the ID's last allow or deny rule are
+ * collected in its program mask. Of the rate and burst rules after that
+ * rule, the last ones set the ID's token bucket.
+ * 
+ * @param set Filter rule set
+ * @param table Decision table to fill, not read by filter checks meanwhile
+ */
+static void filters_build(sc_filter_set_t *set, sc_filter_decision_t *table) {
+    sc_filter_decision_t bounds = { .allow = 1U, .min_size = 0U, .max_size = 0xFFU, .max_priority = 0xFFU };
+    uint16_t id;
+    uint8_t i;
+
+    for (id = 0U; id < SAFECORE_MAX_EVENT_TYPES; id++) {
+        table[id].allow = SC_FILTER_UNDECIDED;
+#if SAFECORE_FILTER_VM_ENABLED == 1
+        table[id].programs = 0U;
+#endif
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+        table[id].rate = 0U;
+        table[id].burst = 0U;
+#endif
+    }
+
+    for (i = set->count; i > 0U; i--) {
+        const sc_filter_rule_t *rule = &set->rules[i - 1U];
+
+        if (rule->enabled == 0U) {
+            continue;
+        }
+
+        switch (rule->type) {
+            case SC_FILTER_TYPE_ALLOW:
+            case SC_FILTER_TYPE_DENY:
+                if ((rule->event_id < SAFECORE_MAX_EVENT_TYPES) &&
+                    (table[rule->event_id].allow == SC_FILTER_UNDECIDED)) {
+                    sc_filter_decision_t later = table[rule->event_id];
+                    table[rule->event_id] = bounds;
+                    table[rule->event_id].allow = (rule->type == SC_FILTER_TYPE_ALLOW) ? 1U : 0U;
+#if SAFECORE_FILTER_VM_ENABLED == 1
+                    table[rule->event_id].programs = later.programs;
+#endif
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+                    table[rule->event_id].rate = later.rate;
+                    table[rule->event_id].burst = later.burst;
+#endif
+                    (void)later;
+                }
+                break;
+            case SC_FILTER_TYPE_SIZE_MIN:
+                if (rule->param > bounds.min_size) {
+                    bounds.min_size = rule->param;
+                }
+                break;
+            case SC_FILTER_TYPE_SIZE_MAX:
+                if (rule->param < bounds.max_size) {
+                    bounds.max_size = rule->param;
+                }
+                break;
+#if SAFECORE_PRIORITY_ENABLED == 1
+            case SC_FILTER_TYPE_PRIORITY:
+                if (rule->param < bounds.max_priority) {
+                    bounds.max_priority = rule->param;
+                }
+                break;
+#endif
+#if SAFECORE_FILTER_VM_ENABLED == 1
+            case SC_FILTER_TYPE_PROGRAM:
+                if ((rule->event_id < SAFECORE_MAX_EVENT_TYPES) &&
+                    (table[rule->event_id].allow == SC_FILTER_UNDECIDED) &&
+                    (filters_rule_program(set, rule) != NULL)) {
+                    table[rule->event_id].programs |= (uint8_t)(1U << rule->param);
+                }
+                break;
+#endif
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+            case SC_FILTER_TYPE_RATE:
+            case SC_FILTER_TYPE_BURST:
+                if ((rule->event_id < SAFECORE_MAX_EVENT_TYPES) &&
+                    (table[rule->event_id].allow == SC_FILTER_UNDECIDED) && (rule->param != 0U)) {
+                    uint8_t *setting = (rule->type == SC_FILTER_TYPE_RATE) ?
+                                       &table[rule->event_id].rate : &table[rule->event_id].burst;
+                    if (*setting == 0U) {
+                        *setting = rule->param; /* Walking backwards: the last rule wins */
+                    }
+                }
+                break;
+#endif
+            default:
+                /* Unknown rule type, ignored */
+                break;
+        }
+    }
+
+    /* IDs without an allow or deny rule */
+    for (id = 0U; id < SAFECORE_MAX_EVENT_TYPES; id++) {
+        if (table[id].allow == SC_FILTER_UNDECIDED) {
+            sc_filter_decision_t later = table[id];
+            table[id] = bounds;
+#if SAFECORE_FILTER_VM_ENABLED == 1
+            table[id].programs = later.programs;
+#endif
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+            table[id].rate = later.rate;
+            table[id].burst = later.burst;
+#endif
+            (void)later;
+        }
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+        if (table[id].rate == 0U) {
+            table[id].burst = 0U;
+            /* Refill when a rate is set again; drop counts are kept */
+            set->buckets[id].flags &= (uint8_t)~(SC_FILTER_BUCKET_PRIMED | SC_FILTER_BUCKET_LIMITING);
+        } else if (table[id].burst == 0U) {
+            table[id].burst = table[id].rate; /* One second's worth */
+        } else {
+            /* Explicit burst */
+        }
+#endif
+    }
+}
+
+#if (SAFECORE_FILTER_SWAP_ENABLED == 1) && (SAFECORE_FILTER_VM_ENABLED == 1)
+/**
+ * @brief Copy the program slots into the next table
+ * 
+ * A slot that still holds the program of the active table keeps its
+ * memory, so a swap does not restart e.g. a deadband.
+ * 
+ * @param set Filter rule set
+ * @param cur Active table, or NULL before the first swap
+ * @param next Table to fill
+ */
+static void filters_stage_programs(const sc_filter_set_t *set, const sc_filter_table_t *cur,
+                                   sc_filter_table_t *next) {
+    uint8_t slot;
+
+    for (slot = 0U; slot < SAFECORE_FILTER_PROGRAMS; slot++) {
+        const sc_fvm_program_t *src = &set->programs[slot];
+
+        next->programs[slot] = *src;
+        if ((cur != NULL) && (src->len != 0U) && (cur->programs[slot].len == src->len) &&
+            (memcmp(cur->programs[slot].insns, src->insns, (size_t)src->len * sizeof(sc_fvm_insn_t)) == 0)) {
+            (void)memcpy(next->programs[slot].mem, cur->programs[slot].mem, sizeof(src->mem));
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Compile the filter rules of an instance into its decision table
+ * 
+ * With table swapping, builds the table not in use and then publishes it
+ * with one atomic store. The table retired by the previous swap is only
+ * rebuilt once the checks still reading it have left (a grace period in
+ * the style of RCU), so this call may spin briefly.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_filters_compile(sc_bus_t *bus) {
+    if (bus == NULL) {
+        return;
+    }
+
+#if SAFECORE_FILTER_SWAP_ENABLED == 1
+    sc_filter_set_t *set = &bus->filters;
+    sc_filter_table_t *cur = atomic_load(&set->active);
+    sc_filter_table_t *next = (cur == &set->tables[0]) ? &set->tables[1] : &set->tables[0];
+
+    /* Grace period: checks that entered next before the last swap */
+    while (atomic_load(&set->readers[(size_t)(next - set->tables)]) != 0U) {
+        /* Spin */
+    }
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+    filters_stage_programs(set, cur, next);
+#endif
+    filters_build(set, next->decisions);
+    atomic_store(&set->active, next);
+#else
+    filters_build(&bus->filters, bus->filters.table.decisions);
+#endif
+}
+
+/**
+ * @brief Initialize the filter rules of an instance
+ * 
+ * This function clears all rules of the instance and resets the rule
+ * counter to zero.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_filters_init(sc_bus_t *bus) {
+    if (bus == NULL) {
+        return;
+    }
+
     /* Clear all filter rules */
-    (void)memset(g_rules, 0, sizeof(g_rules));
+    if (bus->filters.rules != NULL) {
+        (void)memset(bus->filters.rules, 0, (size_t)bus->filters.max_rules * sizeof(sc_filter_rule_t));
+    }
     /* Reset rule counter */
-    g_rule_count = 0U;
+    bus->filters.count = 0U;
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+    /* Reset rate limit state and drop counters */
+    (void)memset(bus->filters.buckets, 0, sizeof(bus->filters.buckets));
+    bus->filters.reports = 0U;
+#endif
+    sc_bus_filters_compile(bus);
 }
 
 /**
- * @brief Add a new filter rule
+ * @brief Add a new filter rule to an instance
  * 
- * This function adds a new filter rule to the system if there is space
- * available in the rules array.
+ * This function adds a new filter rule to the instance if there is space
+ * available in its rules array.
  * 
+ * @param bus Event bus instance
  * @param rule Pointer to the rule structure to add
  * @return 0 on success, -1 on failure (invalid rule or no space)
  */
-int sc_filters_add_rule(const sc_filter_rule_t *rule) {
+int sc_bus_filters_add_rule(sc_bus_t *bus, const sc_filter_rule_t *rule) {
     int result = -1;
     
-    if ((rule != NULL) && (g_rule_count < SAFECORE_MAX_FILTER_RULES)) {
+    if ((bus != NULL) && (rule != NULL) && (bus->filters.count < bus->filters.max_rules)) {
         /* Copy the rule into the rules array */
-        g_rules[g_rule_count] = *rule;
-        g_rule_count++;
+        bus->filters.rules[bus->filters.count] = *rule;
+        bus->filters.count++;
+        sc_bus_filters_compile(bus);
         result = 0;
     }
     
@@ -59,121 +430,368 @@ int sc_filters_add_rule(const sc_filter_rule_t *rule) {
 }
 
 /**
- * @brief Remove a filter rule by index
+ * @brief Remove a filter rule of an instance by index
  * 
  * This function removes a filter rule at the specified index, shifting
  * subsequent rules to fill the gap.
  * 
+ * @param bus Event bus instance
  * @param index Index of the rule to remove
  * @return 0 on success, -1 on failure (invalid index)
  */
-int sc_filters_remove_rule(uint8_t index) {
+int sc_bus_filters_remove_rule(sc_bus_t *bus, uint8_t index) {
     int result = -1;
     
-    if (index < g_rule_count) {
+    if ((bus != NULL) && (index < bus->filters.count)) {
+        sc_filter_rule_t *rules = bus->filters.rules;
         uint8_t i;
         /* Shift rules after the removed one to fill the gap */
-        for (i = index; i < (g_rule_count - 1U); i++) {
-            g_rules[i] = g_rules[i + 1U];
+        for (i = index; i < (bus->filters.count - 1U); i++) {
+            rules[i] = rules[i + 1U];
         }
         /* Decrement rule count */
-        g_rule_count--;
+        bus->filters.count--;
+        sc_bus_filters_compile(bus);
         result = 0;
     }
     
     return result;
 }
 
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+/**
+ * @brief Take a token from the bucket of an event ID
+ * 
+ * Refills the bucket for the time since the last call first. A bucket
+ * starts full when its rate is set.
+ * 
+ * @param set Filter rule set
+ * @param id Event ID
+ * @param d Compiled decision of the ID, with a rate
+ * @return int 1 if a token was taken, 0 if the event is over the limit
+ */
+static int filters_rate_take(sc_filter_set_t *set, uint8_t id, const sc_filter_decision_t *d) {
+    sc_filter_bucket_t *b = &set->buckets[id];
+    uint32_t now = safecore_get_tick_ms();
+    uint32_t depth = (uint32_t)d->burst * SC_FILTER_TOKENS_PER_EVENT;
+
+    if ((b->flags & SC_FILTER_BUCKET_PRIMED) == 0U) {
+        b->tokens = depth;
+        b->flags |= SC_FILTER_BUCKET_PRIMED;
+    } else {
+        uint32_t elapsed = now - b->last_ms;
+        if (elapsed > SC_FILTER_REFILL_MAX_MS) {
+            elapsed = SC_FILTER_REFILL_MAX_MS;
+        }
+        b->tokens += elapsed * d->rate;
+    }
+    if (b->tokens > depth) {
+        b->tokens = depth; /* Also trims a bucket whose burst was lowered */
+    }
+    b->last_ms = now;
+
+    if (b->tokens >= SC_FILTER_TOKENS_PER_EVENT) {
+        b->tokens -= SC_FILTER_TOKENS_PER_EVENT;
+        b->flags &= (uint8_t)~SC_FILTER_BUCKET_LIMITING;
+        return 1;
+    }
+
+    b->dropped++;
+    if ((b->flags & SC_FILTER_BUCKET_LIMITING) == 0U) {
+        /* Limiting kicks in */
+        b->flags |= SC_FILTER_BUCKET_LIMITING;
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+        b->flags |= SC_FILTER_BUCKET_REPORT;
+        set->reports = 1U;
+#endif
+    }
+    return 0;
+}
+#endif
+
 /**
  * @brief Check if an event should be processed based on filter rules
  * 
- * This function evaluates an event against all active filter rules
- * to determine if it should be processed or filtered out.
- * The system operates in whitelist mode by default.
+ * This function looks up the compiled decision of the event's ID: an allow
+ * flag and the size and priority bounds, then runs the ID's filter programs
+ * in slot order until one rejects the event. An event that passes all that
+ * takes a token from the ID's rate limit bucket, if it has one. Events with
+ * IDs outside the table are checked against the rules one by one; with
+ * table swapping they fail, as only the table is safe to read while the
+ * rules change.
  * 
+ * @param bus Event bus instance
  * @param e Pointer to the event to check
+ * @param size Length of the event data in bytes, which filter programs do not read past
  * @return 1 if the event should be processed, 0 if it should be filtered out
  */
-int sc_filters_check_event(const sc_event_t *e) {
-    int result = 0; /* Default to rejecting null events */
-    
-    if (e != NULL) {
-        result = 1; /* Default to allowing events (whitelist mode) */
-        uint8_t i;
-        
-        /* Check event against all active rules */
-        for (i = 0U; i < g_rule_count; i++) {
-            const sc_filter_rule_t *rule = &g_rules[i];
-            
-            if (rule->enabled != 0U) {
-                switch (rule->type) {
-                    case SC_FILTER_TYPE_ALLOW:
-                        if (e->id == rule->event_id) {
-                            result = 1; /* Allow the event */
-                        }
-                        break;
-                    case SC_FILTER_TYPE_DENY:
-                        if (e->id == rule->event_id) {
-                            result = 0; /* Deny the event */
-                        }
-                        break;
-                    case SC_FILTER_TYPE_SIZE_MIN:
-                        if (e->size < rule->param) {
-                            result = 0; /* Size too small */
-                        }
-                        break;
-                    case SC_FILTER_TYPE_SIZE_MAX:
-                        if (e->size > rule->param) {
-                            result = 0; /* Size too large */
-                        }
-                        break;
-                    case SC_FILTER_TYPE_PRIORITY:
-                        if (e->priority > rule->param) {
-                            result = 0; /* Priority too low */
-                        }
-                        break;
-                    default:
-                        /* Unknown rule type, maintain current behavior */
-                        break;
-                }
+int sc_bus_filters_check_event(sc_bus_t *bus, const sc_event_t *e, size_t size) {
+    if ((bus == NULL) || (e == NULL)) {
+        return 0; /* Default to rejecting null events */
+    }
+
+    if (e->id >= SAFECORE_MAX_EVENT_TYPES) {
+#if SAFECORE_FILTER_SWAP_ENABLED == 1
+        return 0;
+#else
+        return filters_walk(&bus->filters, e, size);
+#endif
+    }
+
+    int result = 1;
+    sc_filter_table_t *t = filters_acquire(&bus->filters);
+    const sc_filter_decision_t *d = &t->decisions[e->id];
+    if ((d->allow == 0U) || (e->size < d->min_size) || (e->size > d->max_size)
+#if SAFECORE_PRIORITY_ENABLED == 1
+        || (e->priority > d->max_priority)
+#endif
+       ) {
+        result = 0;
+    }
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+    if ((result != 0) && (d->programs != 0U)) {
+        uint8_t slot;
+        for (slot = 0U; (slot < SAFECORE_FILTER_PROGRAMS) && (result != 0); slot++) {
+            if (((d->programs & (1U << slot)) != 0U) &&
+                (sc_fvm_run(&t->programs[slot], e, size) == 0U)) {
+                result = 0; /* Rejected by the program */
             }
         }
     }
-    
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+    if ((result != 0) && (d->rate != 0U) && (filters_rate_take(&bus->filters, e->id, d) == 0)) {
+        result = 0; /* Over the rate limit */
+    }
+#endif
+
+    filters_release(&bus->filters, t);
     return result;
 }
 
 /**
- * @brief Load filter rules from a buffer
+ * @brief Replace the rules of an instance
+ * 
+ * @param bus Event bus instance
+ * @param rules Rule data, possibly unaligned
+ * @param count Number of rules (at most bus->filters.max_rules)
+ */
+static void filters_install_rules(sc_bus_t *bus, const uint8_t *rules, size_t count) {
+    uint8_t i;
+
+    /* Clear and copy rules; rate limit state carries over */
+    if (bus->filters.rules != NULL) {
+        (void)memset(bus->filters.rules, 0, (size_t)bus->filters.max_rules * sizeof(sc_filter_rule_t));
+    }
+    if (count > 0U) {
+        (void)memcpy(bus->filters.rules, rules, count * sizeof(sc_filter_rule_t));
+    }
+    bus->filters.count = (uint8_t)count;
+
+    /* Validate all loaded rules */
+    for (i = 0U; i < bus->filters.count; i++) {
+        /* Disable rules with invalid types */
+        if (bus->filters.rules[i].type > SC_FILTER_TYPE_LAST) {
+            bus->filters.rules[i].enabled = 0U;
+        }
+    }
+    sc_bus_filters_compile(bus);
+}
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+/**
+ * @brief Load a filter image into an instance
+ * 
+ * Checks the layout and verifies every program before replacing anything,
+ * so a bad image leaves the current rules and programs in place.
+ * 
+ * @param bus Event bus instance
+ * @param buffer Image data, possibly unaligned
+ * @param size Size of the image in bytes
+ * @return int 0 on success, -1 on failure
+ */
+static int filters_load_image(sc_bus_t *bus, const uint8_t *buffer, size_t size) {
+    sc_filter_image_header_t hdr;
+    sc_filter_image_program_t ph;
+    sc_fvm_insn_t insns[SAFECORE_FILTER_PROGRAM_LEN];
+    size_t offsets[SAFECORE_FILTER_PROGRAMS];
+    uint8_t lens[SAFECORE_FILTER_PROGRAMS];
+    uint8_t i;
+
+    (void)memcpy(&hdr, buffer, sizeof(hdr));
+    if ((hdr.reserved != 0U) || (hdr.rule_count > bus->filters.max_rules) ||
+        (hdr.program_count > SAFECORE_FILTER_PROGRAMS)) {
+        return -1;
+    }
+
+    size_t pos = sizeof(hdr) + ((size_t)hdr.rule_count * sizeof(sc_filter_rule_t));
+    if (pos > size) {
+        return -1;
+    }
+
+    /* Walk and verify the programs */
+    for (i = 0U; i < hdr.program_count; i++) {
+        if ((size - pos) < sizeof(ph)) {
+            return -1;
+        }
+        (void)memcpy(&ph, &buffer[pos], sizeof(ph));
+        pos += sizeof(ph);
+
+        size_t bytes = (size_t)ph.len * sizeof(sc_fvm_insn_t);
+        if ((ph.reserved[0] != 0U) || (ph.reserved[1] != 0U) || (ph.reserved[2] != 0U) ||
+            (ph.len > SAFECORE_FILTER_PROGRAM_LEN) || ((size - pos) < bytes)) {
+            return -1;
+        }
+        (void)memcpy(insns, &buffer[pos], bytes);
+        if ((ph.len > 0U) && (sc_fvm_verify(insns, ph.len) != 0)) {
+            return -1;
+        }
+        offsets[i] = pos;
+        lens[i] = ph.len;
+        pos += bytes;
+    }
+    if (pos != size) {
+        return -1;
+    }
+
+    /* Everything checked: replace programs, then rules */
+    sc_fvm_program_t *slots = filters_slots(&bus->filters);
+    (void)memset(slots, 0, SAFECORE_FILTER_PROGRAMS * sizeof(sc_fvm_program_t));
+    for (i = 0U; i < hdr.program_count; i++) {
+        if (lens[i] > 0U) {
+            (void)memcpy(insns, &buffer[offsets[i]], (size_t)lens[i] * sizeof(sc_fvm_insn_t));
+            (void)sc_fvm_load(&slots[i], insns, lens[i]);
+        }
+    }
+    filters_install_rules(bus, &buffer[sizeof(hdr)], hdr.rule_count);
+    return 0;
+}
+
+/**
+ * @brief Load a filter program into a slot of an instance
+ * 
+ * @param bus Event bus instance
+ * @param slot Program slot
+ * @param insns Instructions
+ * @param len Number of instructions, 0 to empty the slot
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_filters_load_program(sc_bus_t *bus, uint8_t slot, const sc_fvm_insn_t *insns, size_t len) {
+    if ((bus == NULL) || (slot >= SAFECORE_FILTER_PROGRAMS)) {
+        return -1;
+    }
+
+    sc_fvm_program_t *prog = &filters_slots(&bus->filters)[slot];
+    if (len == 0U) {
+        (void)memset(prog, 0, sizeof(*prog));
+    } else if (sc_fvm_load(prog, insns, len) != 0) {
+        return -1;
+    } else {
+        /* Loaded */
+    }
+
+    /* Program rules on an empty slot are skipped by the compiled table */
+    sc_bus_filters_compile(bus);
+    return 0;
+}
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+/**
+ * @brief Get the number of events of an ID dropped by its rate limit
+ * 
+ * @param bus Event bus instance
+ * @param event_id Event ID
+ * @return uint32_t Number of dropped events since the filters were initialized
+ */
+uint32_t sc_bus_filters_rate_dropped(const sc_bus_t *bus, uint8_t event_id) {
+    if ((bus == NULL) || (event_id >= SAFECORE_MAX_EVENT_TYPES)) {
+        return 0U;
+    }
+
+    return bus->filters.buckets[event_id].dropped;
+}
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+/**
+ * @brief Publish the pending rate limit summary events of an instance
+ * 
+ * The pending flag is cleared before publishing, so the summaries can pass
+ * through the publish path that called this function.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_filters_rate_report(sc_bus_t *bus) {
+    uint16_t id;
+
+    if ((bus == NULL) || (bus->filters.reports == 0U)) {
+        return;
+    }
+
+    bus->filters.reports = 0U;
+    for (id = 0U; id < SAFECORE_MAX_EVENT_TYPES; id++) {
+        sc_filter_bucket_t *b = &bus->filters.buckets[id];
+        if ((b->flags & SC_FILTER_BUCKET_REPORT) != 0U) {
+            sc_filter_rate_event_t ev;
+
+            b->flags &= (uint8_t)~SC_FILTER_BUCKET_REPORT;
+            (void)memset(&ev, 0, sizeof(ev));
+            ev.header.timestamp = safecore_get_tick_ms();
+            ev.header.id = SAFECORE_FILTER_RATE_REPORT_ID;
+            ev.header.size = (uint8_t)sizeof(sc_filter_rate_event_t);
+#if SAFECORE_PRIORITY_ENABLED == 1
+            ev.header.priority = SAFECORE_STANDARD_PRIORITY;
+#endif
+            ev.event_id = (uint8_t)id;
+            sc_filter_table_t *t = filters_acquire(&bus->filters);
+            ev.rate = t->decisions[id].rate;
+            filters_release(&bus->filters, t);
+            ev.dropped = (b->dropped > 0xFFFFU) ? 0xFFFFU : (uint16_t)b->dropped;
+            (void)sc_bus_publish_raw(bus, (const uint8_t *)&ev, sizeof(ev));
+        }
+    }
+}
+#endif
+#endif
+
+/**
+ * @brief Load filter rules from a buffer into an instance
  * 
  * This function loads multiple filter rules from a memory buffer,
- * validates them, and initializes the filter system with these rules.
+ * validates them, and replaces the rules of the instance with them.
+ * With filter programs, a buffer starting with SC_FILTER_IMAGE_MAGIC is
+ * loaded as a filter image.
  * 
+ * @param bus Event bus instance
  * @param buffer Pointer to buffer containing rule data
  * @param size Size of the buffer in bytes
  * @return 0 on success, -1 on failure
  */
-int sc_filters_load_rules_from_buffer(const uint8_t *buffer, size_t size) {
+int sc_bus_filters_load_rules_from_buffer(sc_bus_t *bus, const uint8_t *buffer, size_t size) {
     int result = -1;
-    
+
+    if ((bus == NULL) || (buffer == NULL) || (size == 0U)) {
+        return -1;
+    }
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+    if (size >= sizeof(sc_filter_image_header_t)) {
+        uint32_t magic;
+        (void)memcpy(&magic, buffer, sizeof(magic));
+        if (magic == SC_FILTER_IMAGE_MAGIC) {
+            return filters_load_image(bus, buffer, size);
+        }
+    }
+#endif
+
     /* Validate buffer and size */
-    if ((buffer != NULL) && (size > 0U) && ((size % sizeof(sc_filter_rule_t)) == 0U)) {
+    if ((size % sizeof(sc_filter_rule_t)) == 0U) {
         size_t rule_count = size / sizeof(sc_filter_rule_t);
         
-        if (rule_count <= SAFECORE_MAX_FILTER_RULES) {
-            /* Initialize system and copy rules */
-            sc_filters_init();
-            (void)memcpy(g_rules, buffer, size);
-            g_rule_count = (uint8_t)rule_count;
-
-            /* Validate all loaded rules */
-            uint8_t i;
-            for (i = 0U; i < g_rule_count; i++) {
-                /* Disable rules with invalid types */
-            if (g_rules[i].type >= (SC_FILTER_TYPE_PRIORITY + 1U)) {
-                    g_rules[i].enabled = 0U;
-                }
-            }
+        if (rule_count <= bus->filters.max_rules) {
+            filters_install_rules(bus, buffer, rule_count);
             result = 0;
         }
     }
@@ -181,4 +799,206 @@ int sc_filters_load_rules_from_buffer(const uint8_t *buffer, size_t size) {
     return result;
 }
 
+#if SAFECORE_FILTER_FILE_ENABLED == 1
+/**
+ * @brief Load filter rules from a file into an instance
+ * 
+ * Reads the whole file first, so a file that cannot be read or does not
+ * validate leaves the current rules in place.
+ * 
+ * @param bus Event bus instance
+ * @param path Path of the filter file
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_filters_load_file(sc_bus_t *bus, const char *path) {
+    uint8_t buffer[SC_FILTER_FILE_MAX_BYTES + 1U];
+
+    if ((bus == NULL) || (path == NULL)) {
+        return -1;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    /* One byte more than accepted, to detect an oversized file */
+    size_t size = fread(buffer, 1U, sizeof(buffer), f);
+    int failed = ferror(f);
+    (void)fclose(f);
+    if ((failed != 0) || (size > SC_FILTER_FILE_MAX_BYTES)) {
+        return -1;
+    }
+
+    return sc_bus_filters_load_rules_from_buffer(bus, buffer, size);
+}
+
+/**
+ * @brief Start watching a filter file
+ * 
+ * @param w Watch to initialize
+ * @param path Path of the filter file
+ */
+void sc_filter_watch_init(sc_filter_watch_t *w, const char *path) {
+    if (w != NULL) {
+        (void)memset(w, 0, sizeof(*w));
+        w->path = path;
+    }
+}
+
+/**
+ * @brief Reload a watched filter file into an instance if it changed
+ * 
+ * @param bus Event bus instance
+ * @param w Watch of the file
+ * @return int 1 if the file was reloaded, 0 if unchanged, -1 on failure
+ */
+int sc_bus_filters_watch(sc_bus_t *bus, sc_filter_watch_t *w) {
+    struct stat st;
+
+    if ((bus == NULL) || (w == NULL) || (w->path == NULL) || (stat(w->path, &st) != 0)) {
+        return -1;
+    }
+
+    if ((w->seen != 0U) && (w->inode == (uint64_t)st.st_ino) &&
+        (w->size == (uint64_t)st.st_size) && (w->mtime == (int64_t)st.st_mtime)) {
+        return 0;
+    }
+
+    /* Remember the file even if it is invalid: it is retried once it changes */
+    w->inode = (uint64_t)st.st_ino;
+    w->size = (uint64_t)st.st_size;
+    w->mtime = (int64_t)st.st_mtime;
+    w->seen = 1U;
+
+    return (sc_bus_filters_load_file(bus, w->path) == 0) ? 1 : -1;
+}
+#endif
+
+/* === Default Instance Filter Interface === */
+
+/**
+ * @brief Initialize the event filtering system
+ * 
+ * This function clears all filter rules of the default event bus instance.
+ */
+void sc_filters_init(void) {
+    sc_bus_filters_init(sc_eventbus_default());
+}
+
+/**
+ * @brief Add a new filter rule
+ * 
+ * This function adds a new filter rule to the default instance.
+ * 
+ * @param rule Pointer to the rule structure to add
+ * @return 0 on success, -1 on failure (invalid rule or no space)
+ */
+int sc_filters_add_rule(const sc_filter_rule_t *rule) {
+    return sc_bus_filters_add_rule(sc_eventbus_default(), rule);
+}
+
+/**
+ * @brief Remove a filter rule by index
+ * 
+ * This function removes a filter rule of the default instance.
+ * 
+ * @param index Index of the rule to remove
+ * @return 0 on success, -1 on failure (invalid index)
+ */
+int sc_filters_remove_rule(uint8_t index) {
+    return sc_bus_filters_remove_rule(sc_eventbus_default(), index);
+}
+
+/**
+ * @brief Compile the filter rules into the decision table
+ * 
+ * This function recompiles the rules of the default instance.
+ */
+void sc_filters_compile(void) {
+    sc_bus_filters_compile(sc_eventbus_default());
+}
+
+/**
+ * @brief Check if an event should be processed based on filter rules
+ * 
+ * This function evaluates an event against the rules of the default instance.
+ * 
+ * @param e Pointer to the event to check
+ * @param size Length of the event data in bytes
+ * @return 1 if the event should be processed, 0 if it should be filtered out
+ */
+int sc_filters_check_event(const sc_event_t *e, size_t size) {
+    return sc_bus_filters_check_event(sc_eventbus_default(), e, size);
+}
+
+/**
+ * @brief Load filter rules from a buffer
+ * 
+ * This function replaces the rules of the default instance.
+ * 
+ * @param buffer Pointer to buffer containing rule data
+ * @param size Size of the buffer in bytes
+ * @return 0 on success, -1 on failure
+ */
+int sc_filters_load_rules_from_buffer(const uint8_t *buffer, size_t size) {
+    return sc_bus_filters_load_rules_from_buffer(sc_eventbus_default(), buffer, size);
+}
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+/**
+ * @brief Load a filter program into a slot
+ * 
+ * This function loads a program into a slot of the default instance.
+ * 
+ * @param slot Program slot
+ * @param insns Instructions
+ * @param len Number of instructions, 0 to empty the slot
+ * @return 0 on success, -1 on failure
+ */
+int sc_filters_load_program(uint8_t slot, const sc_fvm_insn_t *insns, size_t len) {
+    return sc_bus_filters_load_program(sc_eventbus_default(), slot, insns, len);
+}
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+/**
+ * @brief Get the number of events of an ID dropped by its rate limit
+ * 
+ * This function reads the drop counter of the default instance.
+ * 
+ * @param event_id Event ID
+ * @return Number of dropped events
+ */
+uint32_t sc_filters_rate_dropped(uint8_t event_id) {
+    return sc_bus_filters_rate_dropped(sc_eventbus_default(), event_id);
+}
+#endif
+
+#if SAFECORE_FILTER_FILE_ENABLED == 1
+/**
+ * @brief Load filter rules from a file
+ * 
+ * This function replaces the rules of the default instance.
+ * 
+ * @param path Path of the filter file
+ * @return 0 on success, -1 on failure
+ */
+int sc_filters_load_file(const char *path) {
+    return sc_bus_filters_load_file(sc_eventbus_default(), path);
+}
+
+/**
+ * @brief Reload a watched filter file if it changed
+ * 
+ * This function reloads the file into the default instance.
+ * 
+ * @param w Watch of the file
+ * @return 1 if the file was reloaded, 0 if unchanged, -1 on failure
+ */
+int sc_filters_watch(sc_filter_watch_t *w) {
+    return sc_bus_filters_watch(sc_eventbus_default(), w);
+}
+#endif
+
 #endif /* SAFECORE_FILTERS_ENABLED */
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 #include "safecore_types.h"
 #include "safecore_config.h"
+#include "safecore_core.h"
+#include "safecore_fvm.h"
 
 #if SAFECORE_FILTERS_ENABLED == 1
 
@@ -20,6 +22,239 @@
  * @{
  */
 
+#if SAFECORE_FILTER_VM_ENABLED == 1
+#define SC_FILTER_IMAGE_MAGIC       0x31464353UL /* "SCF1" in little-endian byte order */
+
+/**
+ * @brief Header of a filter image
+ * 
+ * A filter image is a rule buffer extended with filter programs: the
+ * header, rule_count sc_filter_rule_t, then program_count programs, each an
+ * sc_filter_image_program_t followed by its len instructions. All fields
+ * are in native byte order.
+ */
+typedef struct {
+    uint32_t magic;             /* SC_FILTER_IMAGE_MAGIC */
+    uint8_t rule_count;         /* Rules following the header */
+    uint8_t program_count;      /* Programs following the rules, loaded into slots 0 and up */
+    uint16_t reserved;          /* Must be zero */
+} sc_filter_image_header_t;
+
+/**
+ * @brief Program header in a filter image
+ */
+typedef struct {
+    uint8_t len;                /* Instructions following the header */
+    uint8_t reserved[3];        /* Must be zero */
+} sc_filter_image_program_t;
+#endif
+
+#if SAFECORE_FILTER_FILE_ENABLED == 1
+/**
+ * @brief Largest filter file accepted
+ */
+#if SAFECORE_FILTER_VM_ENABLED == 1
+#define SC_FILTER_FILE_MAX_BYTES    (sizeof(sc_filter_image_header_t) + (255U * sizeof(sc_filter_rule_t)) + \
+                                     (SAFECORE_FILTER_PROGRAMS * (sizeof(sc_filter_image_program_t) + \
+                                      (SAFECORE_FILTER_PROGRAM_LEN * sizeof(sc_fvm_insn_t)))))
+#else
+#define SC_FILTER_FILE_MAX_BYTES    (255U * sizeof(sc_filter_rule_t))
+#endif
+
+/**
+ * @brief Watched filter file
+ * 
+ * Remembers the identity of the file last loaded, so polling it only
+ * reloads after a change. Replace the file by renaming a complete new one
+ * over it: a file rewritten in place can be seen half written.
+ */
+typedef struct {
+    const char *path;           /* Path of the filter file */
+    uint64_t inode;             /* Inode of the file last seen */
+    uint64_t size;              /* Size of the file last seen */
+    int64_t mtime;              /* Modification time of the file last seen, in seconds */
+    uint8_t seen;               /* Whether the fields above are set */
+} sc_filter_watch_t;
+#endif
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+/**
+ * @brief Rate limit summary event
+ * 
+ * Published with ID SAFECORE_FILTER_RATE_REPORT_ID when the rate limit of
+ * an event ID starts dropping events, once per run of dropped events.
+ */
+typedef struct {
+    sc_event_t header;          /* Event header */
+    uint8_t event_id;           /* Event ID being limited */
+    uint8_t rate;               /* Its limit in events per second */
+    uint16_t dropped;           /* Events of the ID dropped so far, saturating (see sc_bus_filters_rate_dropped()) */
+} sc_filter_rate_event_t;
+#endif
+
+/* === Instance Filter Interface === */
+
+/**
+ * @brief Initialize the filter rules of an instance
+ * 
+ * Clears all filter rules of the event bus instance.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_filters_init(sc_bus_t *bus);
+
+/**
+ * @brief Add a filter rule to an instance
+ * 
+ * @param bus Event bus instance
+ * @param rule Pointer to the filter rule to add
+ * @return int 0 on success, -1 on failure (invalid rule or no space)
+ */
+int sc_bus_filters_add_rule(sc_bus_t *bus, const sc_filter_rule_t *rule);
+
+/**
+ * @brief Remove a filter rule from an instance
+ * 
+ * @param bus Event bus instance
+ * @param index Index of the rule to remove
+ * @return int 0 on success, -1 on failure (invalid index)
+ */
+int sc_bus_filters_remove_rule(sc_bus_t *bus, uint8_t index);
+
+/**
+ * @brief Compile the filter rules of an instance into its decision table
+ * 
+ * Called by the functions that add, remove or load rules. Call it after
+ * changing the rule storage directly, e.g. toggling a rule's enabled flag.
+ * 
+ * With SAFECORE_FILTER_SWAP_ENABLED, publishers keep checking events
+ * against the previous table until the new one is complete, then switch
+ * over at once. The functions that change rules and programs must not run
+ * concurrently with each other, nor preempt a publisher on the same core
+ * (e.g. from an interrupt): the compile waits for checks still reading the
+ * table it rebuilds.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_filters_compile(sc_bus_t *bus);
+
+/**
+ * @brief Check if an event passes the filters of an instance
+ * 
+ * Looks up the event's ID in the compiled decision table, so the cost does
+ * not depend on the number of rules. Rules are applied in order and the
+ * last matching rule wins. With table swapping, events with IDs outside
+ * the table fail.
+ * 
+ * With filter programs, the programs of rules on the event's ID run after
+ * the table check and may update their memory.
+ * 
+ * With rate limits, an event that passes everything else takes a token
+ * from its ID's bucket and is dropped if there is none. The buckets are
+ * plain counters: with SAFECORE_MPSC_ENABLED, producers publishing the same
+ * ID concurrently can race on them.
+ * 
+ * @param bus Event bus instance
+ * @param e Pointer to the event to check
+ * @param size Length of the event data in bytes, which filter programs do not read past
+ * @return int 1 if event passes filters, 0 otherwise
+ */
+int sc_bus_filters_check_event(sc_bus_t *bus, const sc_event_t *e, size_t size);
+
+/**
+ * @brief Load filter rules from buffer into an instance
+ * 
+ * The buffer is an array of sc_filter_rule_t or, with filter programs, a
+ * filter image (see sc_filter_image_header_t). An image is verified as a
+ * whole before anything is replaced and replaces all program slots.
+ * 
+ * @param bus Event bus instance
+ * @param buffer Pointer to buffer containing filter rules
+ * @param size Size of buffer in bytes
+ * @return int 0 on success, -1 on failure
+ */
+int sc_bus_filters_load_rules_from_buffer(sc_bus_t *bus, const uint8_t *buffer, size_t size);
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+/**
+ * @brief Load a filter program into a slot of an instance
+ * 
+ * SC_FILTER_TYPE_PROGRAM rules with param = slot then run it on the events
+ * of their event_id; an event the program returns zero for is dropped.
+ * 
+ * @param bus Event bus instance
+ * @param slot Program slot (below SAFECORE_FILTER_PROGRAMS)
+ * @param insns Instructions
+ * @param len Number of instructions, 0 to empty the slot
+ * @return int 0 on success, -1 on failure (invalid slot or program does not verify)
+ */
+int sc_bus_filters_load_program(sc_bus_t *bus, uint8_t slot, const sc_fvm_insn_t *insns, size_t len);
+#endif
+
+#if SAFECORE_FILTER_FILE_ENABLED == 1
+/**
+ * @brief Load filter rules from a file into an instance
+ * 
+ * The file holds what sc_bus_filters_load_rules_from_buffer() accepts.
+ * 
+ * @param bus Event bus instance
+ * @param path Path of the filter file
+ * @return int 0 on success, -1 on failure (I/O error, file too large or invalid contents)
+ */
+int sc_bus_filters_load_file(sc_bus_t *bus, const char *path);
+
+/**
+ * @brief Start watching a filter file
+ * 
+ * @param w Watch to initialize
+ * @param path Path of the filter file, kept by reference
+ */
+void sc_filter_watch_init(sc_filter_watch_t *w, const char *path);
+
+/**
+ * @brief Reload a watched filter file into an instance if it changed
+ * 
+ * Compares the file's inode, size and modification time with those seen
+ * last time. A changed file is loaded once; if it is invalid, the current
+ * rules stay until the file changes again. Meant to be polled, e.g. from
+ * a periodic timer.
+ * 
+ * @param bus Event bus instance
+ * @param w Watch of the file
+ * @return int 1 if the file was reloaded, 0 if unchanged, -1 on failure (file missing or invalid)
+ */
+int sc_bus_filters_watch(sc_bus_t *bus, sc_filter_watch_t *w);
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+/**
+ * @brief Get the number of events of an ID dropped by its rate limit
+ * 
+ * SC_FILTER_TYPE_RATE rules limit the events of their event_id to param
+ * per second, with bursts of up to the param of the ID's last
+ * SC_FILTER_TYPE_BURST rule. Counters are cleared by sc_bus_filters_init()
+ * but kept when rules are added, removed or loaded.
+ * 
+ * @param bus Event bus instance
+ * @param event_id Event ID
+ * @return uint32_t Number of dropped events
+ */
+uint32_t sc_bus_filters_rate_dropped(const sc_bus_t *bus, uint8_t event_id);
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1
+/**
+ * @brief Publish the pending rate limit summary events of an instance
+ * 
+ * The filter check only marks a summary as pending, as it may run while
+ * an event is reserved in a queue. The publish functions call this on
+ * entry, so a summary goes out with the next event published.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_filters_rate_report(sc_bus_t *bus);
+#endif
+#endif
+
 /* === Filter Interface === */
 
 /**
@@ -50,6 +285,13 @@ int sc_filters_add_rule(const sc_filter_rule_t *rule);
  */
 int sc_filters_remove_rule(uint8_t index);
 
+/**
+ * @brief Compile the filter rules into the decision table
+ * 
+ * Only needed after changing the rule storage directly.
+ */
+void sc_filters_compile(void);
+
 /**
  * @brief Check if an event passes all filters
  * 
@@ -57,9 +299,10 @@ int sc_filters_remove_rule(uint8_t index);
  * should be processed or filtered out.
  * 
  * @param e Pointer to the event to check
+ * @param size Length of the event data in bytes
  * @return int 1 if event passes filters, 0 otherwise
  */
-int sc_filters_check_event(const sc_event_t *e);
+int sc_filters_check_event(const sc_event_t *e, size_t size);
 
 /**
  * @brief Load filter rules from buffer
@@ -72,6 +315,46 @@ int sc_filters_check_event(const sc_event_t *e);
  */
 int sc_filters_load_rules_from_buffer(const uint8_t *buffer, size_t size);
 
+#if SAFECORE_FILTER_VM_ENABLED == 1
+/**
+ * @brief Load a filter program into a slot
+ * 
+ * @param slot Program slot (below SAFECORE_FILTER_PROGRAMS)
+ * @param insns Instructions
+ * @param len Number of instructions, 0 to empty the slot
+ * @return int 0 on success, -1 on failure
+ */
+int sc_filters_load_program(uint8_t slot, const sc_fvm_insn_t *insns, size_t len);
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+/**
+ * @brief Get the number of events of an ID dropped by its rate limit
+ * 
+ * @param event_id Event ID
+ * @return uint32_t Number of dropped events
+ */
+uint32_t sc_filters_rate_dropped(uint8_t event_id);
+#endif
+
+#if SAFECORE_FILTER_FILE_ENABLED == 1
+/**
+ * @brief Load filter rules from a file
+ * 
+ * @param path Path of the filter file
+ * @return int 0 on success, -1 on failure
+ */
+int sc_filters_load_file(const char *path);
+
+/**
+ * @brief Reload a watched filter file if it changed
+ * 
+ * @param w Watch of the file
+ * @return int 1 if the file was reloaded, 0 if unchanged, -1 on failure
+ */
+int sc_filters_watch(sc_filter_watch_t *w);
+#endif
+
 /**
  * @}
  */
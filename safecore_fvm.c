@@ -0,0 +1,249 @@
+/*
+ * safecore_fvm.c
+ *
+ * SafeCore Filter Program Implementation
+ * This file implements the verifier and the interpreter of the filter
+ * bytecode.
+ */
+#include "safecore_fvm.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+
+/**
+ * @brief Check a filter program
+ *
+ * @param insns Instructions
+ * @param len Number of instructions
+ * @return int 0 if the program is valid, -1 otherwise
+ */
+int sc_fvm_verify(const sc_fvm_insn_t *insns, size_t len) {
+    size_t pc;
+
+    if ((insns == NULL) || (len == 0U) || (len > (size_t)SAFECORE_FILTER_PROGRAM_LEN)) {
+        return -1;
+    }
+
+    for (pc = 0U; pc < len; pc++) {
+        const sc_fvm_insn_t *in = &insns[pc];
+        uint32_t op = (uint32_t)in->op & ~SC_FVM_SRC_X;
+        int src_x = ((in->op & SC_FVM_SRC_X) != 0U) ? 1 : 0;
+        size_t rest = len - pc - 1U; /* Instructions after this one */
+        int cond = 0;
+
+        if (in->reserved != 0U) {
+            return -1;
+        }
+
+        switch (op) {
+            case SC_FVM_LDB:
+            case SC_FVM_LDH:
+            case SC_FVM_LDW:
+            case SC_FVM_LDI:
+            case SC_FVM_LDLEN:
+            case SC_FVM_TAX:
+            case SC_FVM_TXA:
+            case SC_FVM_ABS:
+            case SC_FVM_RET:
+            case SC_FVM_RETA:
+                if (src_x != 0) {
+                    return -1;
+                }
+                break;
+            case SC_FVM_LDM:
+            case SC_FVM_STM:
+                if ((src_x != 0) || (in->k >= SC_FVM_MEM_WORDS)) {
+                    return -1;
+                }
+#if SAFECORE_MPSC_ENABLED == 1
+                /* Producers run the program concurrently, so memory is read-only */
+                if (op == SC_FVM_STM) {
+                    return -1;
+                }
+#endif
+                break;
+            case SC_FVM_ADD:
+            case SC_FVM_SUB:
+            case SC_FVM_AND:
+            case SC_FVM_OR:
+            case SC_FVM_XOR:
+                break;
+            case SC_FVM_LSH:
+            case SC_FVM_RSH:
+                if ((src_x == 0) && (in->k >= 32U)) {
+                    return -1;
+                }
+                break;
+            case SC_FVM_JA:
+                /* Forward, and not past the last instruction */
+                if ((src_x != 0) || ((size_t)in->k >= rest)) {
+                    return -1;
+                }
+                break;
+            case SC_FVM_JEQ:
+            case SC_FVM_JGT:
+            case SC_FVM_JGE:
+            case SC_FVM_JSET:
+                if (((size_t)in->jt >= rest) || ((size_t)in->jf >= rest)) {
+                    return -1;
+                }
+                cond = 1;
+                break;
+            default:
+                return -1; /* Unknown opcode */
+        }
+
+        if ((cond == 0) && ((in->jt != 0U) || (in->jf != 0U))) {
+            return -1;
+        }
+    }
+
+    /* Every path ends in a return: jumps stay inside, the last one returns */
+    if ((insns[len - 1U].op != SC_FVM_RET) && (insns[len - 1U].op != SC_FVM_RETA)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Load a verified program into a slot
+ *
+ * @param prog Program slot
+ * @param insns Instructions
+ * @param len Number of instructions
+ * @return int 0 on success, -1 if the program does not verify
+ */
+int sc_fvm_load(sc_fvm_program_t *prog, const sc_fvm_insn_t *insns, size_t len) {
+    if ((prog == NULL) || (sc_fvm_verify(insns, len) != 0)) {
+        return -1;
+    }
+
+    (void)memset(prog, 0, sizeof(*prog));
+    (void)memcpy(prog->insns, insns, len * sizeof(sc_fvm_insn_t));
+    prog->len = (uint8_t)len;
+    return 0;
+}
+
+/**
+ * @brief Run a program on an event
+ *
+ * Executes at most prog->len instructions.
+ *
+ * @param prog Program slot holding a verified program
+ * @param e Event
+ * @param len Length of the event data in bytes
+ * @return uint32_t Verdict: non-zero keeps the event, zero drops it
+ */
+uint32_t sc_fvm_run(sc_fvm_program_t *prog, const sc_event_t *e, size_t len) {
+    const uint8_t *data = (const uint8_t *)(const void *)e;
+    uint32_t a = 0U;
+    uint32_t x = 0U;
+    size_t pc = 0U;
+
+    if ((prog == NULL) || (e == NULL) || (prog->len == 0U)) {
+        return 1U;
+    }
+
+    /* Loads stay inside both the size field and the data */
+    uint32_t size = ((size_t)e->size < len) ? (uint32_t)e->size : (uint32_t)len;
+    while (pc < prog->len) {
+        const sc_fvm_insn_t *in = &prog->insns[pc];
+        uint32_t src = ((in->op & SC_FVM_SRC_X) != 0U) ? x : in->k;
+        pc++;
+
+        switch ((uint32_t)in->op & ~SC_FVM_SRC_X) {
+            case SC_FVM_LDB:
+                if (in->k >= size) {
+                    return 1U; /* Past the event */
+                }
+                a = data[in->k];
+                break;
+            case SC_FVM_LDH: {
+                uint16_t h;
+                if ((size < sizeof(h)) || (in->k > (size - sizeof(h)))) {
+                    return 1U;
+                }
+                (void)memcpy(&h, &data[in->k], sizeof(h));
+                a = h;
+                break;
+            }
+            case SC_FVM_LDW:
+                if ((size < sizeof(a)) || (in->k > (size - sizeof(a)))) {
+                    return 1U;
+                }
+                (void)memcpy(&a, &data[in->k], sizeof(a));
+                break;
+            case SC_FVM_LDI:
+                a = in->k;
+                break;
+            case SC_FVM_LDLEN:
+                a = e->size;
+                break;
+            case SC_FVM_LDM:
+                a = prog->mem[in->k];
+                break;
+            case SC_FVM_STM:
+                prog->mem[in->k] = a;
+                break;
+            case SC_FVM_TAX:
+                x = a;
+                break;
+            case SC_FVM_TXA:
+                a = x;
+                break;
+            case SC_FVM_ADD:
+                a += src;
+                break;
+            case SC_FVM_SUB:
+                a -= src;
+                break;
+            case SC_FVM_AND:
+                a &= src;
+                break;
+            case SC_FVM_OR:
+                a |= src;
+                break;
+            case SC_FVM_XOR:
+                a ^= src;
+                break;
+            case SC_FVM_LSH:
+                a = (src < 32U) ? (a << src) : 0U;
+                break;
+            case SC_FVM_RSH:
+                a = (src < 32U) ? (a >> src) : 0U;
+                break;
+            case SC_FVM_ABS:
+                if ((int32_t)a < 0) {
+                    a = 0U - a;
+                }
+                break;
+            case SC_FVM_JA:
+                pc += in->k;
+                break;
+            case SC_FVM_JEQ:
+                pc += (a == src) ? in->jt : in->jf;
+                break;
+            case SC_FVM_JGT:
+                pc += (a > src) ? in->jt : in->jf;
+                break;
+            case SC_FVM_JGE:
+                pc += (a >= src) ? in->jt : in->jf;
+                break;
+            case SC_FVM_JSET:
+                pc += ((a & src) != 0U) ? in->jt : in->jf;
+                break;
+            case SC_FVM_RET:
+                return in->k;
+            case SC_FVM_RETA:
+                return a;
+            default:
+                return 1U; /* Not reached for verified programs */
+        }
+    }
+
+    return 1U;
+}
+
+#endif /* SAFECORE_FILTER_VM_ENABLED */
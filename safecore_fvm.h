@@ -0,0 +1,108 @@
+/*
+ * safecore_fvm.h
+ *
+ * SafeCore Filter Program Interface
+ * This file defines the bytecode of payload-inspecting filter rules and its
+ * verifier and interpreter. A program is an accumulator machine in the
+ * style of classic BPF: it loads fields of the event at fixed offsets into
+ * the accumulator A, masks and compares them and returns a verdict. Jumps
+ * only go forward, so a verified program runs at most one pass over its
+ * instructions.
+ *
+ * Registers:  A (accumulator), X (index), M[0..SC_FVM_MEM_WORDS-1] (memory
+ *             kept between events, zeroed when the program is loaded; with
+ *             MPSC queues programs run on every producer thread, so SC_FVM_STM
+ *             is rejected and the memory stays zero)
+ * Verdict:    non-zero keeps the event, zero drops it
+ */
+#ifndef SAFECORE_FVM_H
+#define SAFECORE_FVM_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include <stddef.h>
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+
+/* Loads and moves */
+#define SC_FVM_LDB                  0x01U   /* A = event byte at offset k */
+#define SC_FVM_LDH                  0x02U   /* A = event 16-bit word at offset k (native byte order) */
+#define SC_FVM_LDW                  0x03U   /* A = event 32-bit word at offset k (native byte order) */
+#define SC_FVM_LDI                  0x04U   /* A = k */
+#define SC_FVM_LDLEN                0x05U   /* A = event size field */
+#define SC_FVM_LDM                  0x06U   /* A = M[k] */
+#define SC_FVM_STM                  0x07U   /* M[k] = A */
+#define SC_FVM_TAX                  0x08U   /* X = A */
+#define SC_FVM_TXA                  0x09U   /* A = X */
+
+/* Arithmetic and logic, operand k or X with SC_FVM_SRC_X */
+#define SC_FVM_ADD                  0x10U   /* A = A + src */
+#define SC_FVM_SUB                  0x11U   /* A = A - src */
+#define SC_FVM_AND                  0x12U   /* A = A & src */
+#define SC_FVM_OR                   0x13U   /* A = A | src */
+#define SC_FVM_XOR                  0x14U   /* A = A ^ src */
+#define SC_FVM_LSH                  0x15U   /* A = A << src (src below 32) */
+#define SC_FVM_RSH                  0x16U   /* A = A >> src (src below 32) */
+#define SC_FVM_ABS                  0x17U   /* A = |A| taken as a signed value */
+
+/* Jumps, forward only; conditional jumps compare A with k or X */
+#define SC_FVM_JA                   0x20U   /* Skip k instructions */
+#define SC_FVM_JEQ                  0x21U   /* Skip jt if A == src, else jf */
+#define SC_FVM_JGT                  0x22U   /* Skip jt if A > src (unsigned), else jf */
+#define SC_FVM_JGE                  0x23U   /* Skip jt if A >= src (unsigned), else jf */
+#define SC_FVM_JSET                 0x24U   /* Skip jt if (A & src) != 0, else jf */
+
+/* Verdicts */
+#define SC_FVM_RET                  0x30U   /* Return k */
+#define SC_FVM_RETA                 0x31U   /* Return A */
+
+#define SC_FVM_SRC_X                0x80U   /* Flag: ALU or conditional jump operand is X */
+
+/**
+ * @brief Build an instruction
+ */
+#define SC_FVM_INSN(op, jt, jf, k)  { (uint8_t)(op), (uint8_t)(jt), (uint8_t)(jf), 0U, (uint32_t)(k) }
+
+/**
+ * @brief Check a filter program
+ *
+ * Accepts a program only if every opcode is known, every jump lands inside
+ * the program, memory indexes and constant shifts are in range, reserved
+ * bytes are zero and the last instruction returns. With SAFECORE_MPSC_ENABLED
+ * programs that store to memory are rejected.
+ *
+ * @param insns Instructions
+ * @param len Number of instructions (1 to SAFECORE_FILTER_PROGRAM_LEN)
+ * @return int 0 if the program is valid, -1 otherwise
+ */
+int sc_fvm_verify(const sc_fvm_insn_t *insns, size_t len);
+
+/**
+ * @brief Load a verified program into a slot
+ *
+ * Clears the program's memory.
+ *
+ * @param prog Program slot
+ * @param insns Instructions
+ * @param len Number of instructions
+ * @return int 0 on success, -1 if the program does not verify
+ */
+int sc_fvm_load(sc_fvm_program_t *prog, const sc_fvm_insn_t *insns, size_t len);
+
+/**
+ * @brief Run a program on an event
+ *
+ * Loads are bounded by the event's size field and by the length of the
+ * event data, whichever is smaller, so a size field larger than the data
+ * cannot make a program read past it. A load past the bound stops the
+ * program and keeps the event, as the program cannot judge it.
+ *
+ * @param prog Program slot holding a verified program
+ * @param e Event
+ * @param len Length of the event data in bytes
+ * @return uint32_t Verdict: non-zero keeps the event, zero drops it
+ */
+uint32_t sc_fvm_run(sc_fvm_program_t *prog, const sc_event_t *e, size_t len);
+
+#endif /* SAFECORE_FILTER_VM_ENABLED */
+#endif /* SAFECORE_FVM_H */
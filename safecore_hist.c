@@ -0,0 +1,142 @@
+/*
+ * safecore_hist.c
+ *
+ * SafeCore Histogram Implementation
+ * This file implements the log-bucketed histogram used for queue latency
+ * and depth statistics.
+ */
+#include "safecore_hist.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+
+#define SC_HIST_SUB_COUNT           (1U << SC_HIST_SUB_BITS)
+#define SC_HIST_SUB_MASK            (SC_HIST_SUB_COUNT - 1U)
+
+/**
+ * @brief Get the index of the highest set bit
+ *
+ * @param value Non-zero value
+ * @return uint32_t Bit index
+ */
+SAFECORE_INLINE uint32_t hist_msb(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31U - (uint32_t)__builtin_clz(value);
+#else
+    uint32_t n = 0U;
+    while ((value >> 1) != 0U) {
+        value >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief Get the bucket of a value
+ *
+ * Values below 2^SC_HIST_SUB_BITS have a bucket each. Above that, the
+ * position of the highest bit picks the power of two and the next
+ * SC_HIST_SUB_BITS bits pick the bucket within it.
+ *
+ * @param value Value
+ * @return uint32_t Bucket index, below SC_HIST_BUCKETS
+ */
+SAFECORE_INLINE uint32_t hist_bucket(uint32_t value) {
+    uint32_t bucket;
+
+    if (value < SC_HIST_SUB_COUNT) {
+        bucket = value;
+    } else {
+        uint32_t shift = hist_msb(value) - SC_HIST_SUB_BITS;
+        bucket = ((shift + 1U) << SC_HIST_SUB_BITS) + ((value >> shift) & SC_HIST_SUB_MASK);
+        if (bucket >= SC_HIST_BUCKETS) {
+            bucket = SC_HIST_BUCKETS - 1U;
+        }
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Record a value
+ *
+ * @param h Histogram
+ * @param value Value to record
+ */
+void sc_hist_record(sc_hist_t *h, uint32_t value) {
+    if (h == NULL) {
+        return;
+    }
+
+    h->counts[hist_bucket(value)]++;
+    h->count++;
+    h->sum += value;
+    if (value > h->max) {
+        h->max = value;
+    }
+}
+
+/**
+ * @brief Get the lowest value counted in a bucket
+ *
+ * @param bucket Bucket index
+ * @return uint32_t Lowest value of the bucket
+ */
+uint32_t sc_hist_bucket_low(uint32_t bucket) {
+    if (bucket < SC_HIST_SUB_COUNT) {
+        return bucket;
+    }
+
+    uint32_t shift = (bucket >> SC_HIST_SUB_BITS) - 1U;
+    return ((bucket & SC_HIST_SUB_MASK) | SC_HIST_SUB_COUNT) << shift;
+}
+
+/**
+ * @brief Get a quantile of the recorded values
+ *
+ * @param h Histogram
+ * @param permille Quantile in thousandths
+ * @return uint32_t Quantile value, 0 if the histogram is empty
+ */
+uint32_t sc_hist_quantile(const sc_hist_t *h, uint16_t permille) {
+    uint32_t bucket;
+    uint64_t seen = 0U;
+
+    if ((h == NULL) || (h->count == 0U)) {
+        return 0U;
+    }
+    if (permille > 1000U) {
+        permille = 1000U;
+    }
+
+    /* Rank of the requested value, rounded up, at least the first */
+    uint64_t rank = (((uint64_t)h->count * permille) + 999U) / 1000U;
+    if (rank == 0U) {
+        rank = 1U;
+    }
+
+    for (bucket = 0U; bucket < (SC_HIST_BUCKETS - 1U); bucket++) {
+        seen += h->counts[bucket];
+        if (seen >= rank) {
+            uint32_t high = sc_hist_bucket_low(bucket + 1U) - 1U;
+            return (high < h->max) ? high : h->max;
+        }
+    }
+
+    return h->max;
+}
+
+/**
+ * @brief Reset a histogram to the empty state
+ *
+ * @param h Histogram
+ */
+void sc_hist_reset(sc_hist_t *h) {
+    if (h != NULL) {
+        (void)memset(h, 0, sizeof(*h));
+    }
+}
+
+#endif /* SAFECORE_HISTOGRAM_ENABLED */
@@ -0,0 +1,74 @@
+/*
+ * safecore_hist.h
+ *
+ * SafeCore Histogram Interface
+ * This file defines the log-bucketed histogram used for queue latency and
+ * depth statistics. Every power of two is split into 2^SC_HIST_SUB_BITS
+ * buckets, so a bucket is at most a quarter of its value wide at any scale
+ * and recording costs one bit scan and an increment.
+ */
+#ifndef SAFECORE_HIST_H
+#define SAFECORE_HIST_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+
+#define SC_HIST_SUB_BITS            2U  /* log2 of the buckets per power of two */
+#define SC_HIST_BUCKETS \
+    ((((uint32_t)SAFECORE_HIST_RANGE_BITS - SC_HIST_SUB_BITS) + 1U) << SC_HIST_SUB_BITS)
+
+/**
+ * @brief Log-bucketed histogram
+ *
+ * Values of 2^SAFECORE_HIST_RANGE_BITS and above are counted in the last
+ * bucket; max still holds the exact largest value.
+ */
+typedef struct {
+    uint32_t counts[SC_HIST_BUCKETS];   /* Values per bucket */
+    uint32_t count;                     /* Number of recorded values */
+    uint32_t max;                       /* Largest recorded value */
+    uint64_t sum;                       /* Sum of recorded values */
+} sc_hist_t;
+
+/**
+ * @brief Record a value
+ *
+ * Not safe against concurrent recording into the same histogram.
+ *
+ * @param h Histogram
+ * @param value Value to record
+ */
+void sc_hist_record(sc_hist_t *h, uint32_t value);
+
+/**
+ * @brief Get a quantile of the recorded values
+ *
+ * Returns the highest value of the bucket holding the requested rank,
+ * capped at the largest recorded value, so the result is never below the
+ * true quantile.
+ *
+ * @param h Histogram
+ * @param permille Quantile in thousandths, e.g. 990 for p99 and 999 for p99.9
+ * @return uint32_t Quantile value, 0 if the histogram is empty
+ */
+uint32_t sc_hist_quantile(const sc_hist_t *h, uint16_t permille);
+
+/**
+ * @brief Get the lowest value counted in a bucket
+ *
+ * @param bucket Bucket index, below SC_HIST_BUCKETS
+ * @return uint32_t Lowest value of the bucket
+ */
+uint32_t sc_hist_bucket_low(uint32_t bucket);
+
+/**
+ * @brief Reset a histogram to the empty state
+ *
+ * @param h Histogram
+ */
+void sc_hist_reset(sc_hist_t *h);
+
+#endif /* SAFECORE_HISTOGRAM_ENABLED */
+#endif /* SAFECORE_HIST_H */
@@ -20,6 +20,30 @@
     #error "Event filters require basic framework"
 #endif
 
+#if SAFECORE_FILTER_VM_ENABLED == 1 && SAFECORE_FILTERS_ENABLED != 1
+    #error "Filter programs require event filters"
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1 && SAFECORE_FILTERS_ENABLED != 1
+    #error "Filter rate limits require event filters"
+#endif
+
+#if SAFECORE_FILTER_RATE_REPORT_ENABLED == 1 && SAFECORE_FILTER_RATE_ENABLED != 1
+    #error "Rate limit reports require filter rate limits"
+#endif
+
+#if SAFECORE_FILTER_SWAP_ENABLED == 1 && SAFECORE_FILTERS_ENABLED != 1
+    #error "Filter table swapping requires event filters"
+#endif
+
+#if SAFECORE_FILTER_FILE_ENABLED == 1 && SAFECORE_FILTERS_ENABLED != 1
+    #error "Filter file reloading requires event filters"
+#endif
+
+#if SAFECORE_FILTER_FILE_ENABLED == 1 && !defined(__unix__) && !defined(__APPLE__)
+    #error "Filter file reloading is implemented with POSIX stat"
+#endif
+
 #if SAFECORE_DIAGNOSTICS_ENABLED == 1 && SAFECORE_BASIC_ENABLED != 1
     #error "Diagnostics require basic framework"
 #endif
@@ -32,6 +56,75 @@
     #error "Safety mechanisms require basic framework"
 #endif
 
+#if SAFECORE_POOL_ENABLED == 1 && SAFECORE_BASIC_ENABLED != 1
+    #error "Event pools require basic framework"
+#endif
+
+#if SAFECORE_ACTIVE_ENABLED == 1 && SAFECORE_BASIC_ENABLED != 1
+    #error "Active objects require basic framework"
+#endif
+
+#if SAFECORE_TIMER_ENABLED == 1 && SAFECORE_BASIC_ENABLED != 1
+    #error "Timers require basic framework"
+#endif
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1 && SAFECORE_MPSC_ENABLED == 1
+    #error "Variable-length queues support a single producer only"
+#endif
+
+#if SAFECORE_COALESCE_ENABLED == 1 && SAFECORE_MPSC_ENABLED == 1
+    #error "Event coalescing overwrites queued events in place and needs a single producer"
+#endif
+
+#if SAFECORE_WAIT_ENABLED == 1 && SAFECORE_MPSC_ENABLED != 1
+    #error "Blocking wait requires MPSC queues so other threads can publish"
+#endif
+
+#if SAFECORE_WAIT_ENABLED == 1 && !defined(__linux__)
+    #error "Blocking wait is implemented with Linux futexes"
+#endif
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1 && SAFECORE_PRIORITY_ENABLED != 1
+    #error "Latency histograms need the enqueue timestamp of priority events"
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1 && SAFECORE_PRIORITY_ENABLED != 1
+    #error "Spill files hold the low priority levels and need priority queues"
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1 && SAFECORE_MPSC_ENABLED == 1
+    #error "Spill files have a single producer and cannot be combined with MPSC queues"
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1 && !defined(__unix__) && !defined(__APPLE__)
+    #error "Spill files are implemented with POSIX mmap"
+#endif
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1 && SAFECORE_MPSC_ENABLED == 1
+    #error "Filter rate limits update their token buckets on the publish path and need a single producer"
+#endif
+
+#if SAFECORE_PARALLEL_ENABLED == 1 && SAFECORE_MPSC_ENABLED != 1
+    #error "Parallel dispatch requires MPSC queues so callbacks can publish from worker threads"
+#endif
+
+#if SAFECORE_PRIORITY_ENABLED == 1 && SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF && SAFECORE_MAX_EVENT_SIZE < 32
+    #error "EDF grows the event header to 16 bytes: set SAFECORE_MAX_EVENT_SIZE to at least 32"
+#endif
+
+#if SAFECORE_PROCESS_BUDGET_ENABLED == 1 && SAFECORE_PRIORITY_ENABLED == 1 && \
+    SAFECORE_SCHED_POLICY != SAFECORE_SCHED_STRICT && SAFECORE_SCHED_POLICY != SAFECORE_SCHED_EDF
+    #error "Budgeted processing needs SAFECORE_SCHED_STRICT or SAFECORE_SCHED_EDF"
+#endif
+
+#if SAFECORE_PROCESS_BATCH_ENABLED == 1 && SAFECORE_PRIORITY_ENABLED == 1 && SAFECORE_SCHED_POLICY != SAFECORE_SCHED_STRICT
+    #error "Batched processing drains the levels in strict priority order and needs SAFECORE_SCHED_STRICT"
+#endif
+
+#if SAFECORE_PARALLEL_ENABLED == 1 && SAFECORE_PRIORITY_ENABLED == 1 && SAFECORE_SCHED_POLICY != SAFECORE_SCHED_STRICT
+    #error "Parallel dispatch serves the levels in strict priority order and needs SAFECORE_SCHED_STRICT"
+#endif
+
 /* === Automotive Configuration Checks === */
 #if SAFECORE_AUTOSAR_ENABLED == 1
     #undef SAFECORE_DIAGNOSTICS_ENABLED
@@ -56,7 +149,7 @@
     /* MISRA-C compliant static assertion implementation */
     /* This creates an array with negative size if condition is false, causing compile error */
     #define SC_STATIC_ASSERT(condition, msg) \
-        extern int dummy_array_##msg[1U - 2U * ((condition) ? 0U : 1U)]
+        extern int dummy_array_##msg[(condition) ? 1 : -1]
 #else
     /* Use C11 _Static_assert when not enforcing MISRA compliance */
     #define SC_STATIC_ASSERT(condition, msg) \
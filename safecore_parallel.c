@@ -0,0 +1,255 @@
+/*
+ * safecore_parallel.c
+ *
+ * SafeCore Parallel Dispatch Implementation
+ * This file implements the worker pool on POSIX threads. For each priority
+ * level the processing thread peeks a batch of events in place, publishes it
+ * to the workers and serves lane 0 itself. Every lane walks the whole batch
+ * and only calls the subscribers of its domains, so no per-event hand-off is
+ * needed. The queue slots are released after the barrier.
+ */
+#include "safecore_parallel.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <pthread.h>
+#include <stdint.h>
+
+#if SAFECORE_PARALLEL_ENABLED == 1
+
+/**
+ * @brief Worker pool state
+ */
+typedef struct {
+    pthread_t threads[SAFECORE_PARALLEL_WORKERS];
+    pthread_mutex_t lock;             /* Protects the fields below */
+    pthread_cond_t start_cond;        /* Signals a new batch or stop */
+    pthread_cond_t done_cond;         /* Signals the end of a batch */
+    pthread_mutex_t cycle_lock;       /* One bus cycle at a time */
+    const sc_bus_t *bus;              /* Bus of the current batch */
+    const uint8_t *events[SAFECORE_MAX_EVENTS_PER_CYCLE];
+    uint16_t count;                   /* Events in the current batch */
+    uint16_t busy;                    /* Workers still running the batch */
+    uint32_t generation;              /* Bumped for every batch */
+    uint32_t start_generation;        /* Generation when the threads were started */
+    uint8_t running;                  /* Threads started */
+    uint8_t stopping;                 /* Threads asked to exit */
+} parallel_pool_t;
+
+/* === Global Variables === */
+static parallel_pool_t g_parallel = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+    .cycle_lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+/**
+ * @brief Deliver the current batch to the subscribers of one lane
+ *
+ * @param lane Lane index
+ */
+static void parallel_run_lane(uint8_t lane) {
+    const sc_bus_t *bus = g_parallel.bus;
+    uint16_t n;
+
+    for (n = 0U; n < g_parallel.count; n++) {
+        const sc_event_t *e = (const sc_event_t *)(const void *)g_parallel.events[n];
+        sc_subscriber_index_t i;
+
+        if (e->id >= SAFECORE_MAX_EVENT_TYPES) {
+            continue;
+        }
+
+        i = bus->dispatch_heads[e->id];
+        while (i != SC_SUBSCRIBER_NONE) {
+            const subscriber_entry_t *sub = &bus->subscribers[i];
+            if ((sub->domain % SC_PARALLEL_LANES) == lane) {
+                if (sub->callback != NULL) {
+                    sub->callback(e, sub->ctx);
+                } else {
+                    SAFECORE_ON_ERROR("Null subscriber callback!");
+                }
+            }
+            i = sub->next;
+        }
+    }
+}
+
+/**
+ * @brief Worker thread
+ *
+ * @param arg Lane index
+ * @return void* Always NULL
+ */
+static void* parallel_worker(void *arg) {
+    uint8_t lane = (uint8_t)(uintptr_t)arg;
+    uint32_t seen;
+
+    (void)pthread_mutex_lock(&g_parallel.lock);
+    seen = g_parallel.start_generation;
+    for (;;) {
+        while ((g_parallel.generation == seen) && (g_parallel.stopping == 0U)) {
+            (void)pthread_cond_wait(&g_parallel.start_cond, &g_parallel.lock);
+        }
+        if (g_parallel.stopping != 0U) {
+            break;
+        }
+        seen = g_parallel.generation;
+        (void)pthread_mutex_unlock(&g_parallel.lock);
+
+        parallel_run_lane(lane);
+
+        (void)pthread_mutex_lock(&g_parallel.lock);
+        g_parallel.busy--;
+        if (g_parallel.busy == 0U) {
+            (void)pthread_cond_signal(&g_parallel.done_cond);
+        }
+    }
+    (void)pthread_mutex_unlock(&g_parallel.lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Stop and join the first n worker threads
+ *
+ * @param n Number of started threads
+ */
+static void parallel_join(uint8_t n) {
+    uint8_t i;
+
+    (void)pthread_mutex_lock(&g_parallel.lock);
+    g_parallel.stopping = 1U;
+    (void)pthread_cond_broadcast(&g_parallel.start_cond);
+    (void)pthread_mutex_unlock(&g_parallel.lock);
+
+    for (i = 0U; i < n; i++) {
+        (void)pthread_join(g_parallel.threads[i], NULL);
+    }
+
+    g_parallel.stopping = 0U;
+    g_parallel.running = 0U;
+}
+
+/**
+ * @brief Start the worker threads
+ *
+ * @return int 0 on success, -1 if the threads could not be created
+ */
+int sc_parallel_start(void) {
+    uint8_t i;
+
+    if (g_parallel.running != 0U) {
+        return 0;
+    }
+
+    g_parallel.start_generation = g_parallel.generation;
+    for (i = 0U; i < SAFECORE_PARALLEL_WORKERS; i++) {
+        if (pthread_create(&g_parallel.threads[i], NULL, parallel_worker,
+                           (void *)(uintptr_t)(i + 1U)) != 0) {
+            parallel_join(i);
+            return -1;
+        }
+    }
+
+    g_parallel.running = 1U;
+    return 0;
+}
+
+/**
+ * @brief Stop and join the worker threads
+ */
+void sc_parallel_stop(void) {
+    if (g_parallel.running != 0U) {
+        parallel_join(SAFECORE_PARALLEL_WORKERS);
+    }
+}
+
+/**
+ * @brief Check whether the worker threads are running
+ *
+ * @return int 1 if running, 0 otherwise
+ */
+int sc_parallel_active(void) {
+    return (g_parallel.running != 0U) ? 1 : 0;
+}
+
+/**
+ * @brief Deliver the events in g_parallel.events on all lanes
+ *
+ * Serves lane 0 on the calling thread and returns once every lane is done.
+ *
+ * @param bus Event bus instance
+ * @param count Number of events
+ */
+static void parallel_run_batch(const sc_bus_t *bus, uint16_t count) {
+    /* Hand the batch to the workers */
+    (void)pthread_mutex_lock(&g_parallel.lock);
+    g_parallel.bus = bus;
+    g_parallel.count = count;
+    g_parallel.busy = SAFECORE_PARALLEL_WORKERS;
+    g_parallel.generation++;
+    (void)pthread_cond_broadcast(&g_parallel.start_cond);
+    (void)pthread_mutex_unlock(&g_parallel.lock);
+
+    parallel_run_lane(0U);
+
+    /* Barrier: every lane is done with this batch */
+    (void)pthread_mutex_lock(&g_parallel.lock);
+    while (g_parallel.busy != 0U) {
+        (void)pthread_cond_wait(&g_parallel.done_cond, &g_parallel.lock);
+    }
+    (void)pthread_mutex_unlock(&g_parallel.lock);
+}
+
+/**
+ * @brief Process pending events of an instance on the worker pool
+ *
+ * @param bus Event bus instance
+ * @return int 0 on success, -1 if the workers are not running or the bus is invalid
+ */
+int sc_bus_parallel_process(sc_bus_t *bus) {
+    size_t sizes[SAFECORE_MAX_EVENTS_PER_CYCLE];
+    uint8_t level;
+
+    if ((bus == NULL) || (bus->queues == NULL) || (g_parallel.running == 0U)) {
+        return -1;
+    }
+
+    (void)pthread_mutex_lock(&g_parallel.cycle_lock);
+
+    if (bus->peek_level != SC_BUS_NO_LEVEL) {
+        /* The slot held by sc_bus_peek() would stop the batch peek of its
+           level: deliver it first, on the lanes of its subscribers */
+        sc_queue_t *q = &bus->queues[bus->peek_level];
+        g_parallel.events[0] = sc_queue_peek(q, &sizes[0]);
+        if (g_parallel.events[0] != NULL) {
+            parallel_run_batch(bus, 1U);
+        }
+        sc_queue_release(q);
+        sc_bus_ready_refresh(bus, bus->peek_level);
+        bus->peek_level = SC_BUS_NO_LEVEL;
+    }
+
+    for (level = sc_bus_next_ready(bus, 0U); level < bus->priorities;
+         level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+        sc_queue_t *q = &bus->queues[level];
+        uint16_t n = sc_queue_peek_batch(q, g_parallel.events, sizes, SAFECORE_MAX_EVENTS_PER_CYCLE);
+
+        if (n == 0U) {
+            sc_bus_ready_refresh(bus, level);
+            continue;
+        }
+
+        parallel_run_batch(bus, n);
+
+        /* Hand the delivered slots back to producers */
+        sc_queue_release(q);
+        sc_bus_ready_refresh(bus, level);
+    }
+
+    (void)pthread_mutex_unlock(&g_parallel.cycle_lock);
+    return 0;
+}
+
+#endif /* SAFECORE_PARALLEL_ENABLED */
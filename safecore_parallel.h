@@ -0,0 +1,76 @@
+/*
+ * safecore_parallel.h
+ *
+ * SafeCore Parallel Dispatch Module
+ * This header file defines the worker pool that runs subscriber callbacks on
+ * several threads. Subscribers declare an execution domain; every domain is
+ * served by one thread, so callbacks of one domain never run concurrently and
+ * see events in queue order.
+ */
+
+#ifndef SAFECORE_PARALLEL_H
+#define SAFECORE_PARALLEL_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include "safecore_core.h"
+
+#if SAFECORE_PARALLEL_ENABLED == 1
+
+/**
+ * @defgroup SafeCore_PARALLEL SafeCore Parallel Dispatch Module
+ * @brief Worker-thread subscriber execution per domain
+ * @{
+ */
+
+/* Number of lanes; lane 0 is the thread calling sc_bus_process() */
+#define SC_PARALLEL_LANES         (SAFECORE_PARALLEL_WORKERS + 1U)
+
+/**
+ * @brief Start the worker threads
+ *
+ * Until started, and after sc_parallel_stop(), events are delivered on the
+ * processing thread as usual.
+ *
+ * @return int 0 on success, -1 if the threads could not be created
+ */
+int sc_parallel_start(void);
+
+/**
+ * @brief Stop and join the worker threads
+ *
+ * Must not be called while a bus is being processed.
+ */
+void sc_parallel_stop(void);
+
+/**
+ * @brief Check whether the worker threads are running
+ *
+ * @return int 1 if running, 0 otherwise
+ */
+int sc_parallel_active(void);
+
+/**
+ * @brief Process pending events of an instance on the worker pool
+ *
+ * Takes up to SAFECORE_MAX_EVENTS_PER_CYCLE events from each priority level,
+ * highest first, and hands them to all lanes at once. A lane delivers the
+ * events in queue order to the subscribers whose domain maps to it
+ * (domain % SC_PARALLEL_LANES). Each level ends with a barrier: all its
+ * callbacks have returned before the next level starts, and all events are
+ * delivered when the function returns. An event held by sc_bus_peek() is
+ * delivered on the lanes before the first level.
+ *
+ * Callbacks must not process a bus themselves. Callbacks in different domains
+ * run concurrently and must not share unprotected state.
+ *
+ * @param bus Event bus instance
+ * @return int 0 on success, -1 if the workers are not running or the bus is invalid
+ */
+int sc_bus_parallel_process(sc_bus_t *bus);
+
+/** @} *//* End of SafeCore_PARALLEL group */
+
+#endif /* SAFECORE_PARALLEL_ENABLED */
+
+#endif /* SAFECORE_PARALLEL_H */
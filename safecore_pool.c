@@ -0,0 +1,295 @@
+/*
+ * safecore_pool.c
+ *
+ * SafeCore Event Pool Implementation
+ * This file implements the fixed-block payload pools. Each size class keeps
+ * a free bitmap claimed by CAS and one atomic reference count per block, so
+ * blocks may be allocated and released from ISRs and threads concurrently.
+ */
+#include "safecore_pool.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#if SAFECORE_POOL_ENABLED == 1
+
+/* A handle event must fit a queue slot of the default bus */
+SC_STATIC_ASSERT(sizeof(sc_pool_event_t) <= SAFECORE_MAX_EVENT_SIZE,
+                 safecore_pool_event_must_fit_event_size);
+
+/* Free bitmap with the low n bits set */
+#define SC_POOL_MASK(n)           (((n) >= 32U) ? 0xFFFFFFFFU : ((1UL << (n)) - 1UL))
+
+/**
+ * @brief One block size class
+ */
+typedef struct {
+    uint8_t *blocks;              /* count * block_size bytes of payload storage */
+    _Atomic uint32_t *refs;       /* Reference count per block, 0 when free */
+    uint32_t *sizes;              /* Payload size per block */
+    _Atomic uint32_t free_mask;   /* Bit set for each free block */
+    uint32_t block_size;          /* Block size in bytes */
+    uint8_t count;                /* Number of blocks */
+} pool_class_t;
+
+/* === Global Variables === */
+static uint64_t g_pool_small[(SAFECORE_POOL_SMALL_SIZE * SAFECORE_POOL_SMALL_COUNT) / 8];
+static uint64_t g_pool_medium[(SAFECORE_POOL_MEDIUM_SIZE * SAFECORE_POOL_MEDIUM_COUNT) / 8];
+static uint64_t g_pool_large[(SAFECORE_POOL_LARGE_SIZE * SAFECORE_POOL_LARGE_COUNT) / 8];
+static _Atomic uint32_t g_pool_small_refs[SAFECORE_POOL_SMALL_COUNT];
+static _Atomic uint32_t g_pool_medium_refs[SAFECORE_POOL_MEDIUM_COUNT];
+static _Atomic uint32_t g_pool_large_refs[SAFECORE_POOL_LARGE_COUNT];
+static uint32_t g_pool_small_sizes[SAFECORE_POOL_SMALL_COUNT];
+static uint32_t g_pool_medium_sizes[SAFECORE_POOL_MEDIUM_COUNT];
+static uint32_t g_pool_large_sizes[SAFECORE_POOL_LARGE_COUNT];
+
+static pool_class_t g_pool_classes[SC_POOL_CLASSES] = {
+    { (uint8_t *)g_pool_small, g_pool_small_refs, g_pool_small_sizes,
+      SC_POOL_MASK(SAFECORE_POOL_SMALL_COUNT), SAFECORE_POOL_SMALL_SIZE, SAFECORE_POOL_SMALL_COUNT },
+    { (uint8_t *)g_pool_medium, g_pool_medium_refs, g_pool_medium_sizes,
+      SC_POOL_MASK(SAFECORE_POOL_MEDIUM_COUNT), SAFECORE_POOL_MEDIUM_SIZE, SAFECORE_POOL_MEDIUM_COUNT },
+    { (uint8_t *)g_pool_large, g_pool_large_refs, g_pool_large_sizes,
+      SC_POOL_MASK(SAFECORE_POOL_LARGE_COUNT), SAFECORE_POOL_LARGE_SIZE, SAFECORE_POOL_LARGE_COUNT }
+};
+
+/**
+ * @brief Find the class and block index of a payload pointer
+ *
+ * @param payload Pointer to check
+ * @return sc_pool_handle_t Handle, or SC_POOL_HANDLE_NONE if not the start of a block
+ */
+static sc_pool_handle_t pool_lookup(const void *payload) {
+    const uint8_t *p = (const uint8_t *)payload;
+    uint8_t c;
+
+    if (p == NULL) {
+        return SC_POOL_HANDLE_NONE;
+    }
+
+    for (c = 0U; c < SC_POOL_CLASSES; c++) {
+        const pool_class_t *pc = &g_pool_classes[c];
+        if ((p >= pc->blocks) && (p < &pc->blocks[(size_t)pc->count * pc->block_size])) {
+            size_t offset = (size_t)(p - pc->blocks);
+            if ((offset % pc->block_size) != 0U) {
+                break;
+            }
+            return (sc_pool_handle_t)(((uint16_t)c << 8) | (uint16_t)(offset / pc->block_size));
+        }
+    }
+
+    return SC_POOL_HANDLE_NONE;
+}
+
+/**
+ * @brief Get the class of a handle
+ *
+ * @param handle Block handle
+ * @return pool_class_t* Class, or NULL if the handle is out of range
+ */
+static pool_class_t* pool_class_of(sc_pool_handle_t handle) {
+    uint8_t c = (uint8_t)(handle >> 8);
+
+    if ((c >= SC_POOL_CLASSES) || ((handle & 0xFFU) >= g_pool_classes[c].count)) {
+        return NULL;
+    }
+
+    return &g_pool_classes[c];
+}
+
+/**
+ * @brief Drop one reference to a block
+ *
+ * @param handle Block handle
+ */
+static void pool_release_handle(sc_pool_handle_t handle) {
+    pool_class_t *pc = pool_class_of(handle);
+    uint32_t idx = (uint32_t)handle & 0xFFU;
+
+    if (pc == NULL) {
+        return;
+    }
+
+    uint32_t prev = atomic_fetch_sub_explicit(&pc->refs[idx], 1U, memory_order_acq_rel);
+    if (prev == 1U) {
+        /* Last reference: hand the block back to its pool */
+        (void)atomic_fetch_or_explicit(&pc->free_mask, 1UL << idx, memory_order_release);
+    } else if (prev == 0U) {
+        atomic_store_explicit(&pc->refs[idx], 0U, memory_order_relaxed);
+        SAFECORE_ON_ERROR("Pool block released twice");
+    } else {
+        /* Other references remain */
+    }
+}
+
+/**
+ * @brief Reset all pools
+ *
+ * Marks every block free and clears all reference counts.
+ */
+void sc_pool_init(void) {
+    uint8_t c;
+    uint8_t i;
+
+    for (c = 0U; c < SC_POOL_CLASSES; c++) {
+        pool_class_t *pc = &g_pool_classes[c];
+        for (i = 0U; i < pc->count; i++) {
+            atomic_store_explicit(&pc->refs[i], 0U, memory_order_relaxed);
+        }
+        atomic_store_explicit(&pc->free_mask, SC_POOL_MASK((uint32_t)pc->count), memory_order_release);
+    }
+}
+
+/**
+ * @brief Allocate a payload block
+ *
+ * Claims the lowest free block of the first class that fits by CAS on the
+ * class's free bitmap.
+ *
+ * @param size Payload size in bytes
+ * @return void* Pointer to the payload, or NULL if no block is available
+ */
+void* sc_pool_alloc(size_t size) {
+    uint8_t c;
+
+    if (size == 0U) {
+        return NULL;
+    }
+
+    for (c = 0U; c < SC_POOL_CLASSES; c++) {
+        pool_class_t *pc = &g_pool_classes[c];
+        if (size > pc->block_size) {
+            continue;
+        }
+
+        uint32_t mask = atomic_load_explicit(&pc->free_mask, memory_order_acquire);
+        while (mask != 0U) {
+            uint32_t bit = mask & (~mask + 1U);
+            if (atomic_compare_exchange_weak_explicit(&pc->free_mask, &mask, mask & ~bit,
+                                                      memory_order_acquire,
+                                                      memory_order_acquire)) {
+                uint32_t idx = 0U;
+                while ((bit >> idx) != 1U) {
+                    idx++;
+                }
+                pc->sizes[idx] = (uint32_t)size;
+                atomic_store_explicit(&pc->refs[idx], 1U, memory_order_release);
+                return &pc->blocks[(size_t)idx * pc->block_size];
+            }
+            /* mask was reloaded by the failed CAS */
+        }
+        /* Class exhausted: try the next larger one */
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Take an additional reference to a payload
+ *
+ * Fails on free blocks, so a stale pointer cannot resurrect a block.
+ *
+ * @param payload Pointer to the payload
+ * @return int 0 on success, -1 if the pointer is not a live pool block
+ */
+int sc_pool_retain(const void *payload) {
+    sc_pool_handle_t handle = pool_lookup(payload);
+    pool_class_t *pc = pool_class_of(handle);
+    uint32_t idx = (uint32_t)handle & 0xFFU;
+
+    if (pc == NULL) {
+        return -1;
+    }
+
+    uint32_t refs = atomic_load_explicit(&pc->refs[idx], memory_order_relaxed);
+    while (refs != 0U) {
+        if (atomic_compare_exchange_weak_explicit(&pc->refs[idx], &refs, refs + 1U,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Drop a reference to a payload
+ *
+ * @param payload Pointer to the payload
+ */
+void sc_pool_release(const void *payload) {
+    pool_release_handle(pool_lookup(payload));
+}
+
+/**
+ * @brief Get the handle of a payload
+ *
+ * @param payload Pointer to the payload
+ * @return sc_pool_handle_t Handle, or SC_POOL_HANDLE_NONE if the pointer is not a pool block
+ */
+sc_pool_handle_t sc_pool_handle(const void *payload) {
+    return pool_lookup(payload);
+}
+
+/**
+ * @brief Get the payload carried by a handle event
+ *
+ * @param e Event delivered to a subscriber
+ * @param out_size Pointer to store the payload size (may be NULL)
+ * @return const void* Pointer to the payload, or NULL if the event is not a handle event
+ */
+const void* sc_pool_event_data(const sc_event_t *e, size_t *out_size) {
+    const void *payload = NULL;
+
+    if ((e != NULL) && ((e->flags & SC_EVENT_FLAG_POOLED) != 0U)) {
+        sc_pool_handle_t handle = ((const sc_pool_event_t *)(const void *)e)->handle;
+        const pool_class_t *pc = pool_class_of(handle);
+        uint32_t idx = (uint32_t)handle & 0xFFU;
+
+        if ((pc != NULL) && (atomic_load_explicit(&pc->refs[idx], memory_order_acquire) != 0U)) {
+            payload = &pc->blocks[(size_t)idx * pc->block_size];
+            if (out_size != NULL) {
+                *out_size = pc->sizes[idx];
+            }
+        }
+    }
+
+    return payload;
+}
+
+/**
+ * @brief Drop the reference held by a handle event
+ *
+ * @param e Handle event
+ */
+void sc_pool_release_event(const sc_event_t *e) {
+    if ((e != NULL) && ((e->flags & SC_EVENT_FLAG_POOLED) != 0U)) {
+        pool_release_handle(((const sc_pool_event_t *)(const void *)e)->handle);
+    }
+}
+
+/**
+ * @brief Get pool statistics
+ *
+ * @param free_blocks Array of SC_POOL_CLASSES entries to receive the free block counts
+ */
+void sc_pool_get_stats(uint8_t *free_blocks) {
+    uint8_t c;
+
+    if (free_blocks == NULL) {
+        return;
+    }
+
+    for (c = 0U; c < SC_POOL_CLASSES; c++) {
+        uint32_t mask = atomic_load_explicit(&g_pool_classes[c].free_mask, memory_order_relaxed);
+        uint8_t n = 0U;
+        while (mask != 0U) {
+            mask &= mask - 1U;
+            n++;
+        }
+        free_blocks[c] = n;
+    }
+}
+
+#endif /* SAFECORE_POOL_ENABLED */
@@ -0,0 +1,126 @@
+/*
+ * safecore_pool.h
+ *
+ * SafeCore Event Pool Module
+ * This header file defines fixed-block payload pools with atomic reference
+ * counts. Large payloads are allocated from a pool and published as a small
+ * handle event, so every subscriber shares one copy of the data.
+ */
+
+#ifndef SAFECORE_POOL_H
+#define SAFECORE_POOL_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include <stddef.h>
+
+#if SAFECORE_POOL_ENABLED == 1
+
+/**
+ * @defgroup SafeCore_POOL SafeCore Event Pool Module
+ * @brief Reference-counted payload blocks for zero-copy fan-out
+ * @{
+ */
+
+#define SC_POOL_CLASSES           3U    /* Number of block size classes */
+
+/**
+ * @brief Pool block handle
+ *
+ * Size class in the high byte, block index in the low byte.
+ */
+typedef uint16_t sc_pool_handle_t;
+
+#define SC_POOL_HANDLE_NONE       ((sc_pool_handle_t)0xFFFFU)
+
+/**
+ * @brief Handle event queued by sc_bus_publish_pooled()
+ *
+ * Only the handle travels through the queue. The header's flags carry
+ * SC_EVENT_FLAG_POOLED; subscribers get the payload with sc_pool_event_data().
+ */
+typedef struct {
+    sc_event_t header;            /* Event header */
+    sc_pool_handle_t handle;      /* Payload block */
+    uint16_t reserved;            /* Alignment padding */
+} sc_pool_event_t;
+
+/**
+ * @brief Reset all pools
+ *
+ * Marks every block free. Must not be called while blocks are in use.
+ */
+void sc_pool_init(void);
+
+/**
+ * @brief Allocate a payload block
+ *
+ * Takes a block from the smallest size class that fits, falling back to
+ * larger classes when it is exhausted. The caller holds the only reference.
+ * Safe to call from several contexts concurrently.
+ *
+ * @param size Payload size in bytes
+ * @return void* Pointer to the payload, or NULL if no block is available
+ */
+void* sc_pool_alloc(size_t size);
+
+/**
+ * @brief Take an additional reference to a payload
+ *
+ * Subscribers retain the payload to keep it beyond the callback.
+ *
+ * @param payload Pointer returned by sc_pool_alloc() or sc_pool_event_data()
+ * @return int 0 on success, -1 if the pointer is not a live pool block
+ */
+int sc_pool_retain(const void *payload);
+
+/**
+ * @brief Drop a reference to a payload
+ *
+ * The block returns to its pool when the last reference is dropped.
+ *
+ * @param payload Pointer returned by sc_pool_alloc() or sc_pool_event_data()
+ */
+void sc_pool_release(const void *payload);
+
+/**
+ * @brief Get the handle of a payload
+ *
+ * @param payload Pointer returned by sc_pool_alloc()
+ * @return sc_pool_handle_t Handle, or SC_POOL_HANDLE_NONE if the pointer is not a pool block
+ */
+sc_pool_handle_t sc_pool_handle(const void *payload);
+
+/**
+ * @brief Get the payload carried by a handle event
+ *
+ * The payload is valid for the duration of the subscriber callback; call
+ * sc_pool_retain() on it to keep it longer.
+ *
+ * @param e Event delivered to a subscriber
+ * @param out_size Pointer to store the payload size (may be NULL)
+ * @return const void* Pointer to the payload, or NULL if the event is not a handle event
+ */
+const void* sc_pool_event_data(const sc_event_t *e, size_t *out_size);
+
+/**
+ * @brief Drop the reference held by a handle event
+ *
+ * Called by the event bus when a queued handle event is freed.
+ *
+ * @param e Handle event
+ */
+void sc_pool_release_event(const sc_event_t *e);
+
+/**
+ * @brief Get pool statistics
+ *
+ * @param free_blocks Array of SC_POOL_CLASSES entries to receive the free block counts
+ */
+void sc_pool_get_stats(uint8_t *free_blocks);
+
+/** @} *//* End of SafeCore_POOL group */
+
+#endif /* SAFECORE_POOL_ENABLED */
+
+#endif /* SAFECORE_POOL_H */
@@ -26,6 +26,17 @@ extern "C" {
  */
 extern uint32_t safecore_get_tick_ms(void);
 
+/**
+ * @brief Get current system tick in microseconds
+ * 
+ * High-resolution clock used by time-budgeted event processing. Only
+ * required when SAFECORE_PROCESS_BUDGET_ENABLED is set; the counter may
+ * wrap around.
+ * 
+ * @return uint32_t Current system tick in microseconds
+ */
+extern uint32_t safecore_get_tick_us(void);
+
 /**
  * @brief Handle critical errors
  * 
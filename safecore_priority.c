@@ -10,254 +10,812 @@
 #include "safecore_config.h"
 #include "safecore_module_config.h"
 #include "safecore_core.h"
+#include "safecore_filters.h"
+#include "safecore_queue.h"
+#include "safecore_edf.h"
+#include "safecore_pool.h"
 #include <string.h>
 
 #if SAFECORE_PRIORITY_ENABLED == 1
 
-/* Multi-priority queues */
-static uint8_t g_event_queues[SAFECORE_EVENT_PRIORITIES][SAFECORE_EVENT_QUEUE_SIZE][SAFECORE_MAX_EVENT_SIZE];
-static uint8_t g_event_sizes[SAFECORE_EVENT_PRIORITIES][SAFECORE_EVENT_QUEUE_SIZE];
-static volatile uint8_t g_heads[SAFECORE_EVENT_PRIORITIES];
-static volatile uint8_t g_tails[SAFECORE_EVENT_PRIORITIES];
-static uint32_t g_dropped_events[SAFECORE_EVENT_PRIORITIES] = {0};
-
-/* Subscriber table (obtained from core module) */
-extern subscriber_entry_t g_subscribers[SAFECORE_MAX_SUBSCRIBERS];
-extern uint8_t g_subscriber_count;
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+static void priority_edf_clear(sc_bus_t *bus);
+#endif
 
 /**
- * @brief Check if a priority queue is full
- * 
- * Determines if the specified priority queue has reached its maximum capacity.
- * Uses modulo arithmetic to handle the circular buffer structure.
+ * @brief Initialize priority queue system
  * 
- * @param priority Priority level to check
- * @return uint8_t 1 if the queue is full, 0 otherwise
+ * Resets all priority queues of the default instance to their initial
+ * empty state, including their drop and service counters and histograms.
+ * With EDF scheduling the deadline queue is emptied as well.
  */
-SAFECORE_INLINE uint8_t queue_full(uint8_t priority) {
-    /* Use unsigned suffix to avoid integer overflow */
-    return ((g_heads[priority] + 1U) % SAFECORE_EVENT_QUEUE_SIZE) == g_tails[priority];
-}
+void sc_priority_init(void) {
+    sc_bus_t *bus = sc_eventbus_default();
+    uint8_t i;
 
-/**
- * @brief Check if a priority queue is empty
- * 
- * Determines if the specified priority queue contains any events.
- * 
- * @param priority Priority level to check
- * @return uint8_t 1 if the queue is empty, 0 otherwise
- */
-SAFECORE_INLINE uint8_t queue_empty(uint8_t priority) {
-    return g_heads[priority] == g_tails[priority];
+    if (bus->queues != NULL) {
+        for (i = 0U; i < bus->priorities; i++) {
+            sc_queue_reset(&bus->queues[i]);
+            sc_bus_ready_refresh(bus, i);
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR
+            bus->sched.deficit[i] = 0U;
+#endif
+        }
+        bus->sched.waiting = 0U;
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+        priority_edf_clear(bus);
+#endif
+        sc_bus_priority_reset_service(bus);
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+        sc_bus_priority_reset_histograms(bus);
+#endif
+    }
 }
 
 /**
- * @brief Push data into a priority queue
+ * @brief Publish an event with raw data to an instance
  * 
- * Adds an event to the specified priority queue, handling overflow according to the configured policy.
+ * Adds an event to the appropriate priority queue of the instance based on
+ * the event's priority field. Applies event filtering if enabled.
  * 
- * @param priority Priority level to push to
- * @param data Pointer to the event data to copy
+ * @param bus Event bus instance
+ * @param event_data Pointer to the raw event data
  * @param size Size of the event data
- * @return int 0 on success, -1 on failure (invalid parameters or queue full)
+ * @return int 0 on success, -1 on failure (invalid parameters or queue error)
  */
-SAFECORE_INLINE int queue_push(uint8_t priority, const uint8_t *data, size_t size) {
+int sc_bus_priority_publish_raw(sc_bus_t *bus, const uint8_t *event_data, size_t size) {
     int result = -1;
     
-    if ((data != NULL) && (size > 0U) && (size <= SAFECORE_MAX_EVENT_SIZE) && (priority < SAFECORE_EVENT_PRIORITIES)) {
-        if (queue_full(priority)) {
-#if SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST
-            /* Drop oldest event by advancing tail */
-            g_tails[priority] = (g_tails[priority] + 1) % SAFECORE_EVENT_QUEUE_SIZE;
-            g_dropped_events[priority]++;
-#elif SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_PANIC
-            /* Panic on overflow */
-            SAFECORE_ON_ERROR("Event queue overflow - PANIC");
-            while (1);
+    if ((bus != NULL) && (bus->queues != NULL) && (event_data != NULL) && (size > 0U)) {
+        const sc_event_t *e = (const sc_event_t *)event_data;
+        
+        if (e->id < SAFECORE_MAX_EVENT_TYPES) {
+            uint8_t priority = e->priority;
+            
+            /* Validate priority - fallback to lowest priority if out of range */
+            if (priority >= bus->priorities) {
+                priority = (uint8_t)(bus->priorities - 1U);
+            }
+
+#if SAFECORE_FILTERS_ENABLED == 1
+            /* Apply event filtering if enabled */
+            if (sc_bus_filters_check_event(bus, e, size)) {
+                result = sc_bus_enqueue(bus, priority, event_data, size);
+            } else {
+                SC_LOG("Event %d filtered out", (int)e->id);
+                result = 0; /* Filtered events are considered 'handled' */
+            }
 #else
-            /* Default policy: drop new event */
-            g_dropped_events[priority]++;
-            return -1;
+            /* No filtering - push directly to queue */
+            result = sc_bus_enqueue(bus, priority, event_data, size);
 #endif
         }
-
-        /* Copy event data to queue */
-        (void)memcpy(g_event_queues[priority][g_heads[priority]], data, size);
-        g_event_sizes[priority][g_heads[priority]] = (uint8_t)size;
-        /* Update head pointer (with wrap-around using modulo) */
-        g_heads[priority] = (uint8_t)((g_heads[priority] + 1U) % SAFECORE_EVENT_QUEUE_SIZE);
-        result = 0;
     }
     
     return result;
 }
 
 /**
- * @brief Pop data from a priority queue
+ * @brief Publish an event with raw data
  * 
- * Retrieves and removes the oldest event from the specified priority queue.
+ * Adds an event to the priority queues of the default instance.
  * 
- * @param priority Priority level to pop from
- * @param out_size Pointer to store the size of the popped event
- * @return const uint8_t* Pointer to the popped event data, or NULL if the queue is empty
+ * @param event_data Pointer to the raw event data
+ * @param size Size of the event data
+ * @return int 0 on success, -1 on failure (invalid parameters or queue error)
  */
-SAFECORE_INLINE const uint8_t* queue_pop(uint8_t priority, size_t *out_size) {
-    const uint8_t *e = NULL;
-    
-    if ((priority < SAFECORE_EVENT_PRIORITIES) && (out_size != NULL)) {
-        if (!queue_empty(priority)) {
-            *out_size = g_event_sizes[priority][g_tails[priority]];
-            e = g_event_queues[priority][g_tails[priority]];
-            /* Update tail pointer (with wrap-around using modulo) */
-            g_tails[priority] = (uint8_t)((g_tails[priority] + 1U) % SAFECORE_EVENT_QUEUE_SIZE);
+int sc_priority_publish_raw(const uint8_t *event_data, size_t size) {
+    return sc_bus_priority_publish_raw(sc_eventbus_default(), event_data, size);
+}
+
+#if SAFECORE_SCHED_POLICY != SAFECORE_SCHED_EDF
+/**
+ * @brief Start the wait of levels that became ready since the last call
+ * 
+ * Levels no longer ready stop waiting; newly ready levels start waiting now.
+ * 
+ * @param bus Event bus instance
+ * @param now Current tick in milliseconds
+ */
+static void priority_track_waiting(sc_bus_t *bus, uint32_t now) {
+    sc_prio_mask_t ready = 0U;
+    uint8_t level;
+
+    for (level = sc_bus_next_ready(bus, 0U); level < bus->priorities;
+         level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+        ready |= (sc_prio_mask_t)1U << level;
+        if ((bus->sched.waiting & ((sc_prio_mask_t)1U << level)) == 0U) {
+            bus->sched.since[level] = now;
         }
     }
-    
-    return e;
+
+    bus->sched.waiting = ready;
 }
 
 /**
- * @brief Initialize priority queue system
+ * @brief Record that a level is being served
  * 
- * Resets all priority queues to their initial empty state.
- * Sets all head and tail pointers to zero and initializes drop counters.
+ * @param bus Event bus instance
+ * @param level Priority level
+ * @param now Current tick in milliseconds
  */
-void sc_priority_init(void) {
-    uint8_t i;
-    for (i = 0U; i < SAFECORE_EVENT_PRIORITIES; i++) {
-        g_heads[i] = 0U;
-        g_tails[i] = 0U;
-        g_dropped_events[i] = 0U;
+static void priority_note_service(sc_bus_t *bus, uint8_t level, uint32_t now) {
+    if ((bus->sched.waiting & ((sc_prio_mask_t)1U << level)) == 0U) {
+        /* Became ready during this call */
+        bus->sched.since[level] = now;
+        bus->sched.waiting |= (sc_prio_mask_t)1U << level;
     }
+
+    uint32_t wait = now - bus->sched.since[level];
+
+    if (wait > bus->sched.max_wait_ms[level]) {
+        bus->sched.max_wait_ms[level] = wait;
+    }
+    bus->sched.since[level] = now;
 }
+#endif
 
 /**
- * @brief Publish an event with raw data
+ * @brief Note that a level was found empty
  * 
- * Adds an event to the appropriate priority queue based on the event's priority field.
- * Applies event filtering if enabled.
+ * @param bus Event bus instance
+ * @param level Priority level
+ */
+static void priority_level_drained(sc_bus_t *bus, uint8_t level) {
+    sc_bus_ready_refresh(bus, level);
+    bus->sched.waiting &= ~((sc_prio_mask_t)1U << level);
+}
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_AGING
+/**
+ * @brief Deliver events by aged priority
  * 
- * @param event_data Pointer to the raw event data
- * @param size Size of the event data
- * @return int 0 on success, -1 on failure (invalid parameters or queue error)
+ * The effective priority of a ready level is its level minus one per
+ * SAFECORE_SCHED_AGING_MS since it was last served. The best effective
+ * priority wins; on ties, the level that waited longer. The choice is made
+ * again before every event, so levels that become ready during the call
+ * are considered at once.
+ * 
+ * @param bus Event bus instance
+ * @param now Current tick in milliseconds
  */
-int sc_priority_publish_raw(const uint8_t *event_data, size_t size) {
-    int result = -1;
-    
-    if ((event_data != NULL) && (size > 0U)) {
-        const sc_event_t *e = (const sc_event_t *)event_data;
-        
-        if (e->id < SAFECORE_MAX_EVENT_TYPES) {
-            uint8_t priority = e->priority;
-            
-            /* Validate priority - fallback to low priority if out of range */
-            if (priority >= SAFECORE_EVENT_PRIORITIES) {
-                priority = SAFECORE_LOW_PRIORITY;
+static void priority_process_aging(sc_bus_t *bus, uint32_t now) {
+    uint32_t limit = (uint32_t)bus->priorities * SAFECORE_MAX_EVENTS_PER_CYCLE;
+    uint32_t processed = 0U;
+    sc_prio_mask_t skip = 0U;
+
+    while (processed < limit) {
+        uint8_t best = bus->priorities;
+        uint32_t best_eff = 0U;
+        uint32_t best_age = 0U;
+        uint8_t level;
+
+        for (level = sc_bus_next_ready(bus, 0U); level < bus->priorities;
+             level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+            if ((skip & ((sc_prio_mask_t)1U << level)) != 0U) {
+                continue;
+            }
+            if ((bus->sched.waiting & ((sc_prio_mask_t)1U << level)) == 0U) {
+                /* Became ready during this call */
+                bus->sched.since[level] = now;
+                bus->sched.waiting |= (sc_prio_mask_t)1U << level;
             }
+            uint32_t age = now - bus->sched.since[level];
+            uint32_t boost = age / SAFECORE_SCHED_AGING_MS;
+            uint32_t eff = (level > boost) ? (level - boost) : 0U;
+            if ((best == bus->priorities) || (eff < best_eff) ||
+                ((eff == best_eff) && (age > best_age))) {
+                best = level;
+                best_eff = eff;
+                best_age = age;
+            }
+        }
 
-#if SAFECORE_FILTERS_ENABLED == 1
-            /* Apply event filtering if enabled */
-            if (sc_filters_check_event(e)) {
-                result = queue_push(priority, event_data, size);
-            } else {
-                SC_LOG("Event %d filtered out", (int)e->id);
-                result = 0; /* Filtered events are considered 'handled' */
+        if (best == bus->priorities) {
+            break;
+        }
+
+        sc_queue_t *q = &bus->queues[best];
+        size_t size;
+        const uint8_t *raw = sc_queue_peek(q, &size);
+        if (raw == NULL) {
+            /* Empty, or only holds slots still being written */
+            priority_level_drained(bus, best);
+            skip |= (sc_prio_mask_t)1U << best;
+            continue;
+        }
+
+        priority_note_service(bus, best, now);
+        sc_bus_deliver(bus, best, (const sc_event_t *)raw);
+        sc_queue_release(q);
+        bus->sched.served[best]++;
+        processed++;
+    }
+}
+#elif SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+/**
+ * @brief Get the absolute deadline of an event
+ * 
+ * The deadline is the event's timestamp plus its relative deadline. Events
+ * without a timestamp count from the time they are taken from their level,
+ * events without a relative deadline get SAFECORE_EDF_DEFAULT_DEADLINE_MS.
+ * 
+ * @param raw Event data
+ * @param size Size of the event in bytes
+ * @param now Current tick in milliseconds
+ * @return uint32_t Absolute deadline in milliseconds
+ */
+static uint32_t priority_edf_deadline(const uint8_t *raw, size_t size, uint32_t now) {
+    uint32_t start = now;
+    uint32_t relative = SAFECORE_EDF_DEFAULT_DEADLINE_MS;
+
+    if (size >= sizeof(sc_event_t)) {
+        const sc_event_t *e = (const sc_event_t *)(const void *)raw;
+        if (e->timestamp != 0U) {
+            start = e->timestamp;
+        }
+        if (e->deadline != 0U) {
+            relative = e->deadline;
+        }
+    }
+
+    return start + relative;
+}
+
+/**
+ * @brief Move pending events from the levels into the deadline queue
+ * 
+ * Takes events level by level, highest priority first, until the deadline
+ * queue is full, so under overload the higher levels get in first. Each
+ * level slot is released as soon as its event is copied. A pool handle
+ * event takes its own payload reference, as releasing the level slot drops
+ * the queued one.
+ * 
+ * @param bus Event bus instance
+ */
+static void priority_edf_admit(sc_bus_t *bus) {
+    sc_edf_t *edf = &bus->sched.edf;
+    uint32_t now = safecore_get_tick_ms();
+    uint8_t level;
+
+    for (level = sc_bus_next_ready(bus, 0U);
+         (level < bus->priorities) && (sc_edf_count(edf) < (uint16_t)SAFECORE_EDF_QUEUE_SIZE);
+         level = sc_bus_next_ready(bus, (uint8_t)(level + 1U))) {
+        sc_queue_t *q = &bus->queues[level];
+        const uint8_t *raw = NULL;
+        size_t size;
+
+        while (sc_edf_count(edf) < (uint16_t)SAFECORE_EDF_QUEUE_SIZE) {
+            raw = sc_queue_peek(q, &size);
+            if (raw == NULL) {
+                break;
             }
+            if (sc_edf_push(edf, raw, size, priority_edf_deadline(raw, size, now), level) == 0) {
+#if SAFECORE_POOL_ENABLED == 1
+                const sc_event_t *e = (const sc_event_t *)(const void *)raw;
+                if ((size >= sizeof(sc_pool_event_t)) && ((e->flags & SC_EVENT_FLAG_POOLED) != 0U)) {
+                    (void)sc_pool_retain(sc_pool_event_data(e, NULL));
+                }
+#endif
+            }
+            sc_queue_release(q);
+        }
+
+        if (raw == NULL) {
+            priority_level_drained(bus, level);
+        }
+    }
+}
+
+/**
+ * @brief Remove the event with the earliest deadline after delivery
+ * 
+ * @param edf Deadline queue
+ * @param raw The event, as returned by sc_edf_peek()
+ * @param size Size of the event in bytes
+ */
+static void priority_edf_remove(sc_edf_t *edf, const uint8_t *raw, size_t size) {
+#if SAFECORE_POOL_ENABLED == 1
+    const sc_event_t *e = (const sc_event_t *)(const void *)raw;
+    if ((size >= sizeof(sc_pool_event_t)) && ((e->flags & SC_EVENT_FLAG_POOLED) != 0U)) {
+        sc_pool_release_event(e);
+    }
 #else
-            /* No filtering - push directly to queue */
-            result = queue_push(priority, event_data, size);
+    (void)raw;
+    (void)size;
 #endif
+    sc_edf_pop(edf);
+}
+
+/**
+ * @brief Drop all events of the deadline queue
+ * 
+ * @param bus Event bus instance
+ */
+static void priority_edf_clear(sc_bus_t *bus) {
+    const uint8_t *raw;
+    size_t size;
+
+    while ((raw = sc_edf_peek(&bus->sched.edf, &size, NULL, NULL)) != NULL) {
+        priority_edf_remove(&bus->sched.edf, raw, size);
+    }
+    sc_edf_init(&bus->sched.edf);
+}
+
+/**
+ * @brief Deliver the event with the earliest deadline of an instance
+ * 
+ * An event delivered after its deadline counts as a miss of its level.
+ * 
+ * @param bus Event bus instance
+ * @param admit 1 to move pending level events into the deadline queue first
+ * @return int 1 if an event was delivered, 0 if none was pending
+ */
+int sc_bus_priority_edf_step(sc_bus_t *bus, int admit) {
+    sc_edf_t *edf;
+    const uint8_t *raw;
+    size_t size;
+    uint32_t deadline;
+    uint8_t level;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return 0;
+    }
+
+    edf = &bus->sched.edf;
+    if (admit != 0) {
+        priority_edf_admit(bus);
+    }
+    raw = sc_edf_peek(edf, &size, &deadline, &level);
+    if (raw == NULL) {
+        return 0;
+    }
+
+    if ((int32_t)(safecore_get_tick_ms() - deadline) > 0) {
+        bus->sched.missed[level]++;
+    }
+
+    /* Delivered in place: only processing changes the deadline queue */
+    sc_bus_deliver(bus, level, (const sc_event_t *)(const void *)raw);
+    priority_edf_remove(edf, raw, size);
+    bus->sched.served[level]++;
+
+    return 1;
+}
+
+/**
+ * @brief Deliver events by earliest deadline
+ * 
+ * Before every event, pending events are moved from the levels into the
+ * deadline queue, so an urgent event published by a callback is delivered
+ * next. A call delivers at most SAFECORE_MAX_EVENTS_PER_CYCLE events times
+ * the number of levels.
+ * 
+ * @param bus Event bus instance
+ */
+static void priority_process_edf(sc_bus_t *bus) {
+    uint32_t limit = (uint32_t)bus->priorities * SAFECORE_MAX_EVENTS_PER_CYCLE;
+    uint32_t processed = 0U;
+
+    while ((processed < limit) && (sc_bus_priority_edf_step(bus, 1) != 0)) {
+        processed++;
+    }
+}
+#else
+/**
+ * @brief Progress of one processing call over the priority levels
+ */
+typedef struct {
+    uint8_t used[SAFECORE_EVENT_PRIORITIES];    /* Events delivered per level (strict) */
+    sc_prio_mask_t credited;                    /* Levels whose weight was added (DRR) */
+    sc_prio_mask_t done;                        /* Levels out of quota for this call */
+} priority_cycle_t;
+
+#if SAFECORE_SCHED_PREEMPT == 1
+/**
+ * @brief Check whether a higher level with quota left became ready
+ * 
+ * @param bus Event bus instance
+ * @param level Level being served
+ * @param cycle Progress of the current call
+ * @return int 1 if a higher level should be served first, 0 otherwise
+ */
+static int priority_preempted(const sc_bus_t *bus, uint8_t level, const priority_cycle_t *cycle) {
+    uint8_t higher = sc_bus_next_ready(bus, 0U);
+
+    while ((higher < level) && ((cycle->done & ((sc_prio_mask_t)1U << higher)) != 0U)) {
+        higher = sc_bus_next_ready(bus, (uint8_t)(higher + 1U));
+    }
+
+    return (higher < level) ? 1 : 0;
+}
+#endif
+
+/**
+ * @brief Deliver events of one level up to its quota for this cycle
+ * 
+ * Strict scheduling allows SAFECORE_MAX_EVENTS_PER_CYCLE events. Deficit
+ * round robin adds the level's weight to its deficit once per call and
+ * delivers events, charging their size, while the deficit covers a
+ * maximum-size event. With SAFECORE_SCHED_PREEMPT the level is left after
+ * any event that made a higher level ready.
+ * 
+ * @param bus Event bus instance
+ * @param level Priority level
+ * @param now Current tick in milliseconds
+ * @param cycle Progress of the current call
+ * @return int 1 if preempted by a higher level, 0 otherwise
+ */
+static int priority_serve_level(sc_bus_t *bus, uint8_t level, uint32_t now, priority_cycle_t *cycle) {
+    sc_prio_mask_t bit = (sc_prio_mask_t)1U << level;
+    sc_queue_t *q = &bus->queues[level];
+    const uint8_t *raw;
+    size_t size;
+    int empty = 0;
+    int preempted = 0;
+
+    priority_note_service(bus, level, now);
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR
+    uint32_t *deficit = &bus->sched.deficit[level];
+
+    if ((cycle->credited & bit) == 0U) {
+        *deficit += bus->sched.weight[level];
+        cycle->credited |= bit;
+    }
+
+    /* Take an event only while a maximum-size one would fit, so no event is
+       left held when the credit runs out */
+    while ((*deficit >= q->slot_size) && (preempted == 0)) {
+        raw = sc_queue_peek(q, &size);
+        if (raw == NULL) {
+            empty = 1;
+            break;
         }
+        sc_bus_deliver(bus, level, (const sc_event_t *)raw);
+        sc_queue_release(q);
+        *deficit -= (uint32_t)size;
+        bus->sched.served[level]++;
+#if SAFECORE_SCHED_PREEMPT == 1
+        preempted = priority_preempted(bus, level, cycle);
+#endif
     }
-    
-    return result;
+
+    if (empty != 0) {
+        /* An emptied level keeps no credit */
+        *deficit = 0U;
+    }
+    if (*deficit < q->slot_size) {
+        cycle->done |= bit;
+    }
+#else
+    while ((cycle->used[level] < SAFECORE_MAX_EVENTS_PER_CYCLE) && (preempted == 0)) {
+        /* Get next event from current priority queue */
+        raw = sc_queue_pop(q, &size);
+        if (raw == NULL) {
+            empty = 1;
+            break;
+        }
+        /* Deliver event to the subscribers of its event ID */
+        sc_bus_deliver(bus, level, (const sc_event_t *)raw);
+        cycle->used[level]++;
+        bus->sched.served[level]++;
+#if SAFECORE_SCHED_PREEMPT == 1
+        preempted = priority_preempted(bus, level, cycle);
+#endif
+    }
+
+    /* Hand the last delivered slot back to producers */
+    sc_queue_release(q);
+    if (cycle->used[level] >= SAFECORE_MAX_EVENTS_PER_CYCLE) {
+        cycle->done |= bit;
+    }
+#endif
+
+    if (empty != 0) {
+        priority_level_drained(bus, level);
+    }
+
+    return preempted;
+}
+#endif
+
+/**
+ * @brief Process events from all priority queues of an instance
+ * 
+ * Delivers events according to SAFECORE_SCHED_POLICY through the instance's
+ * dispatch index. Only levels whose bit is set in the instance's ready
+ * bitmap are visited, so empty levels cost nothing; a level found empty has
+ * its bit cleared. With SAFECORE_SCHED_PREEMPT, processing returns to the
+ * highest ready level whenever a delivered event made a higher level ready.
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_priority_process(sc_bus_t *bus) {
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
+
+    /* An event held by sc_bus_peek() is delivered first */
+    (void)sc_bus_deliver_held(bus);
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+    priority_process_edf(bus);
+#else
+    uint32_t now = safecore_get_tick_ms();
+    priority_track_waiting(bus, now);
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_AGING
+    priority_process_aging(bus, now);
+#else
+    priority_cycle_t cycle;
+    uint8_t prio;
+
+    (void)memset(&cycle, 0, sizeof(cycle));
+
+    /* Process from highest to lowest priority, skipping empty levels */
+    prio = sc_bus_next_ready(bus, 0U);
+    while (prio < bus->priorities) {
+        if (((cycle.done & ((sc_prio_mask_t)1U << prio)) == 0U) &&
+            (priority_serve_level(bus, prio, now, &cycle) != 0)) {
+            /* A higher level became ready: start over from the top */
+            prio = sc_bus_next_ready(bus, 0U);
+        } else {
+            prio = sc_bus_next_ready(bus, (uint8_t)(prio + 1U));
+        }
+    }
+#endif
+#endif
+
+#if SAFECORE_SPILL_ENABLED == 1
+    /* Page spilled events back into the queues drained above */
+    sc_bus_spill_refill(bus);
+#endif
+#if SAFECORE_BACKPRESSURE_ENABLED == 1
+    /* Let producers resume on levels drained to their low watermark */
+    sc_bus_backpressure_update(bus);
+#endif
 }
 
 /**
  * @brief Process events from all priority queues
  * 
- * Processes events from all priority queues in order of priority (lowest to highest).
- * For each priority level, processes up to SAFECORE_MAX_EVENTS_PER_CYCLE events.
- * Delivers each event to all subscribers registered for that event type.
+ * Processes the priority queues of the default instance.
  */
 void sc_priority_process(void) {
-    uint8_t prio;
+    sc_bus_priority_process(sc_eventbus_default());
+}
+
+/**
+ * @brief Get the current depth of a priority queue of an instance
+ * 
+ * With EDF scheduling the level's events already in the deadline queue
+ * are included.
+ * 
+ * @param bus Event bus instance
+ * @param priority Priority level to check
+ * @return uint8_t Current depth of the priority queue
+ */
+uint8_t sc_bus_priority_get_queue_depth(const sc_bus_t *bus, uint8_t priority) {
+    uint8_t depth = 0U;
     
-    /* Process from highest to lowest priority */
-    for (prio = 0U; prio < SAFECORE_EVENT_PRIORITIES; prio++) {
-        size_t size;
-        const uint8_t *raw;
-        uint8_t processed = 0U;
-
-        do {
-            /* Get next event from current priority queue */
-            raw = queue_pop(prio, &size);
-            if ((raw != NULL) && (processed < SAFECORE_MAX_EVENTS_PER_CYCLE)) {
-                const sc_event_t *e = (const sc_event_t *)raw;
-                uint8_t i;
-                
-                /* Deliver event to all matching subscribers */
-                for (i = 0U; i < g_subscriber_count; i++) {
-                    if (g_subscribers[i].event_id == e->id) {
-                        if (g_subscribers[i].callback != NULL) {
-                            g_subscribers[i].callback(e, g_subscribers[i].ctx);
-                        } else {
-                            SAFECORE_ON_ERROR("Null subscriber callback!");
-                        }
-                    }
-                }
-                processed++;
-            }
-        } while ((raw != NULL) && (processed < SAFECORE_MAX_EVENTS_PER_CYCLE));
+    if ((bus != NULL) && (bus->queues != NULL) && (priority < bus->priorities)) {
+        depth = (uint8_t)sc_queue_depth(&bus->queues[priority]);
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+        depth = (uint8_t)(depth + sc_edf_level_count(&bus->sched.edf, priority));
+#endif
     }
+    
+    return depth;
 }
 
 /**
  * @brief Get the current depth of a priority queue
  * 
- * Calculates the number of events currently in the specified priority queue.
- * Handles the circular buffer structure to correctly calculate depth.
+ * Calculates the number of events currently in the specified priority queue
+ * of the default instance.
  * 
  * @param priority Priority level to check
  * @return uint8_t Current depth of the priority queue
  */
 uint8_t sc_priority_get_queue_depth(uint8_t priority) {
-    uint8_t depth = 0U;
-    
-    if (priority < SAFECORE_EVENT_PRIORITIES) {
-        /* Use unsigned arithmetic to avoid sign issues */
-        if (g_heads[priority] >= g_tails[priority]) {
-            depth = g_heads[priority] - g_tails[priority];
-        } else {
-            depth = (g_heads[priority] + SAFECORE_EVENT_QUEUE_SIZE) - g_tails[priority];
+    return sc_bus_priority_get_queue_depth(sc_eventbus_default(), priority);
+}
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR
+/**
+ * @brief Set the deficit round robin weight of a priority level of an instance
+ * 
+ * @param bus Event bus instance
+ * @param priority Priority level
+ * @param weight Bytes per round
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_priority_set_weight(sc_bus_t *bus, uint8_t priority, uint16_t weight) {
+    if ((bus == NULL) || (bus->queues == NULL) || (priority >= bus->priorities) || (weight == 0U)) {
+        return -1;
+    }
+
+    bus->sched.weight[priority] = weight;
+    return 0;
+}
+
+/**
+ * @brief Set the deficit round robin weight of a priority level
+ * 
+ * @param priority Priority level
+ * @param weight Bytes per round
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_priority_set_weight(uint8_t priority, uint16_t weight) {
+    return sc_bus_priority_set_weight(sc_eventbus_default(), priority, weight);
+}
+#endif
+
+/**
+ * @brief Get the service counters of the priority levels of an instance
+ * 
+ * @param bus Event bus instance
+ * @param served Array to store delivered event counts (may be NULL)
+ * @param max_wait_ms Array to store the longest waits in milliseconds (may be NULL)
+ */
+void sc_bus_priority_get_service(const sc_bus_t *bus, uint32_t *served, uint32_t *max_wait_ms) {
+    uint8_t i;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
+
+    for (i = 0U; i < bus->priorities; i++) {
+        if (served != NULL) {
+            served[i] = bus->sched.served[i];
+        }
+        if (max_wait_ms != NULL) {
+            max_wait_ms[i] = bus->sched.max_wait_ms[i];
         }
     }
-    
-    return depth;
 }
 
 /**
- * @brief Get statistics for all priority queues
+ * @brief Reset the service counters of the priority levels of an instance
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_priority_reset_service(sc_bus_t *bus) {
+    if (bus != NULL) {
+        (void)memset(bus->sched.served, 0, sizeof(bus->sched.served));
+        (void)memset(bus->sched.max_wait_ms, 0, sizeof(bus->sched.max_wait_ms));
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+        (void)memset(bus->sched.missed, 0, sizeof(bus->sched.missed));
+#endif
+    }
+}
+
+/**
+ * @brief Get the service counters of the priority levels
+ * 
+ * @param served Array to store delivered event counts (may be NULL)
+ * @param max_wait_ms Array to store the longest waits in milliseconds (may be NULL)
+ */
+void sc_priority_get_service(uint32_t *served, uint32_t *max_wait_ms) {
+    sc_bus_priority_get_service(sc_eventbus_default(), served, max_wait_ms);
+}
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+/**
+ * @brief Get the deadline miss counters of the priority levels of an instance
+ * 
+ * @param bus Event bus instance
+ * @param missed Array to store the events delivered late per level
+ */
+void sc_bus_priority_get_deadline_misses(const sc_bus_t *bus, uint32_t *missed) {
+    uint8_t i;
+
+    if ((bus == NULL) || (bus->queues == NULL) || (missed == NULL)) {
+        return;
+    }
+
+    for (i = 0U; i < bus->priorities; i++) {
+        missed[i] = bus->sched.missed[i];
+    }
+}
+
+/**
+ * @brief Get the deadline miss counters of the priority levels
+ * 
+ * @param missed Array to store the events delivered late per level
+ */
+void sc_priority_get_deadline_misses(uint32_t *missed) {
+    sc_bus_priority_get_deadline_misses(sc_eventbus_default(), missed);
+}
+#endif
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+/**
+ * @brief Copy the latency and depth histograms of an instance
+ * 
+ * @param bus Event bus instance
+ * @param out Histograms to fill in
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_priority_get_histograms(const sc_bus_t *bus, sc_bus_hist_t *out) {
+    if ((bus == NULL) || (out == NULL)) {
+        return -1;
+    }
+
+    (void)memcpy(out, &bus->hist, sizeof(*out));
+    return 0;
+}
+
+/**
+ * @brief Reset the latency and depth histograms of an instance
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_priority_reset_histograms(sc_bus_t *bus) {
+    if (bus != NULL) {
+        (void)memset(&bus->hist, 0, sizeof(bus->hist));
+    }
+}
+
+/**
+ * @brief Copy the latency and depth histograms
+ * 
+ * @param out Histograms to fill in
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_priority_get_histograms(sc_bus_hist_t *out) {
+    return sc_bus_priority_get_histograms(sc_eventbus_default(), out);
+}
+
+/**
+ * @brief Reset the latency and depth histograms
+ */
+void sc_priority_reset_histograms(void) {
+    sc_bus_priority_reset_histograms(sc_eventbus_default());
+}
+#endif
+
+/**
+ * @brief Get statistics for all priority queues of an instance
  * 
  * Retrieves depth and dropped event count for all priority levels.
  * 
+ * @param bus Event bus instance
  * @param depths Pointer to an array to store queue depths
  * @param dropped Pointer to an array to store dropped event counts
  */
-void sc_priority_get_stats(uint8_t *depths, uint32_t *dropped) {
+void sc_bus_priority_get_stats(const sc_bus_t *bus, uint8_t *depths, uint32_t *dropped) {
     uint8_t i;
+
+    if ((bus == NULL) || (bus->queues == NULL)) {
+        return;
+    }
     
     if (depths != NULL) {
-        for (i = 0U; i < SAFECORE_EVENT_PRIORITIES; i++) {
-            depths[i] = sc_priority_get_queue_depth(i);
+        for (i = 0U; i < bus->priorities; i++) {
+            depths[i] = sc_bus_priority_get_queue_depth(bus, i);
         }
     }
     
     if (dropped != NULL) {
-        for (i = 0U; i < SAFECORE_EVENT_PRIORITIES; i++) {
-            dropped[i] = g_dropped_events[i];
+        for (i = 0U; i < bus->priorities; i++) {
+            dropped[i] = sc_queue_dropped(&bus->queues[i]);
         }
     }
 }
 
-#endif /* SAFECORE_PRIORITY_ENABLED */
\ No newline at end of file
+/**
+ * @brief Get statistics for all priority queues
+ * 
+ * Retrieves depth and dropped event count for all priority levels of the
+ * default instance.
+ * 
+ * @param depths Pointer to an array to store queue depths
+ * @param dropped Pointer to an array to store dropped event counts
+ */
+void sc_priority_get_stats(uint8_t *depths, uint32_t *dropped) {
+    sc_bus_priority_get_stats(sc_eventbus_default(), depths, dropped);
+}
+
+#endif /* SAFECORE_PRIORITY_ENABLED */
@@ -10,16 +10,156 @@
 
 #include "safecore_types.h"
 #include "safecore_config.h"
+#include "safecore_core.h"
 
 #if SAFECORE_PRIORITY_ENABLED == 1
 
 /* === Priority Queue Interface === */
 
+/**
+ * @brief Publish raw event data to a priority queue of an instance
+ * 
+ * This function publishes raw event data to the queue of the instance
+ * selected by the priority field within the event data. Out-of-range
+ * priorities fall back to the instance's lowest priority level.
+ * 
+ * @param bus Event bus instance
+ * @param event_data Pointer to the event data to be published
+ * @param size Size of the event data in bytes
+ * @return int Returns 0 on success, negative value on failure
+ */
+int sc_bus_priority_publish_raw(sc_bus_t *bus, const uint8_t *event_data, size_t size);
+
+/**
+ * @brief Process events in the priority queues of an instance
+ * 
+ * This function processes events from the instance's priority queues
+ * according to SAFECORE_SCHED_POLICY:
+ * - strict: levels in order, up to SAFECORE_MAX_EVENTS_PER_CYCLE each
+ * - deficit round robin: levels in order, each up to its byte weight
+ * - aging: one event at a time from the level with the best effective
+ *   priority, which rises by one level per SAFECORE_SCHED_AGING_MS the
+ *   level goes unserved; a call delivers at most SAFECORE_MAX_EVENTS_PER_CYCLE
+ *   events times the number of levels
+ * - earliest deadline first: events move from the levels into a deadline
+ *   queue and are delivered by timestamp plus deadline, with the same limit
+ *   per call as aging
+ *
+ * @param bus Event bus instance
+ */
+void sc_bus_priority_process(sc_bus_t *bus);
+
+/**
+ * @brief Get the current depth of a priority queue of an instance
+ * 
+ * @param bus Event bus instance
+ * @param priority Priority level of the queue to query
+ * @return uint8_t Number of events in the specified priority queue
+ */
+uint8_t sc_bus_priority_get_queue_depth(const sc_bus_t *bus, uint8_t priority);
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR
+/**
+ * @brief Set the deficit round robin weight of a priority level
+ * 
+ * Each round the level may deliver up to weight bytes of events; unused
+ * credit carries over while the level stays non-empty. A level's share of
+ * the bus under load is its weight over the sum of the weights.
+ * 
+ * @param bus Event bus instance
+ * @param priority Priority level
+ * @param weight Bytes per round (at least the level's maximum event size)
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_priority_set_weight(sc_bus_t *bus, uint8_t priority, uint16_t weight);
+#endif
+
+/**
+ * @brief Get the service counters of the priority levels of an instance
+ * 
+ * Counts the events delivered per level by sc_bus_priority_process() and the
+ * longest time a level held events without being served, which bounds the
+ * queueing latency of the level's head event. Waits are not tracked with
+ * EDF scheduling, which reports deadline misses instead.
+ * 
+ * @param bus Event bus instance
+ * @param served Array of bus->priorities entries to store delivered event counts (may be NULL)
+ * @param max_wait_ms Array of bus->priorities entries to store the longest waits (may be NULL)
+ */
+void sc_bus_priority_get_service(const sc_bus_t *bus, uint32_t *served, uint32_t *max_wait_ms);
+
+/**
+ * @brief Reset the service counters of the priority levels of an instance
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_priority_reset_service(sc_bus_t *bus);
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+/**
+ * @brief Deliver the event with the earliest deadline of an instance
+ * 
+ * One step of earliest-deadline-first processing, used by the budgeted and
+ * batch processing paths so they keep the deadline order and never leave
+ * events behind in the deadline queue.
+ * 
+ * @param bus Event bus instance
+ * @param admit 1 to move pending level events into the deadline queue first,
+ *              0 to take only events already in it
+ * @return int 1 if an event was delivered, 0 if none was pending
+ */
+int sc_bus_priority_edf_step(sc_bus_t *bus, int admit);
+
+/**
+ * @brief Get the deadline miss counters of the priority levels of an instance
+ * 
+ * Counts the events per level whose deadline had passed when delivery
+ * started. Reset with sc_bus_priority_reset_service().
+ * 
+ * @param bus Event bus instance
+ * @param missed Array of bus->priorities entries to store the events delivered late
+ */
+void sc_bus_priority_get_deadline_misses(const sc_bus_t *bus, uint32_t *missed);
+#endif
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+/**
+ * @brief Copy the latency and depth histograms of an instance
+ * 
+ * Takes a snapshot of the queue wait, callback time and depth histograms
+ * per level and, with SAFECORE_HIST_PER_ID_ENABLED, per event ID. Read
+ * quantiles from the copy with sc_hist_quantile(). Only the processing
+ * context records into the histograms; a snapshot taken from another
+ * context may include a partly recorded event.
+ * 
+ * @param bus Event bus instance
+ * @param out Histograms to fill in
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_bus_priority_get_histograms(const sc_bus_t *bus, sc_bus_hist_t *out);
+
+/**
+ * @brief Reset the latency and depth histograms of an instance
+ * 
+ * @param bus Event bus instance
+ */
+void sc_bus_priority_reset_histograms(sc_bus_t *bus);
+#endif
+
+/**
+ * @brief Get statistics about the priority queues of an instance
+ * 
+ * @param bus Event bus instance
+ * @param depths Array of bus->priorities entries to store queue depths
+ * @param dropped Array of bus->priorities entries to store dropped event counts
+ */
+void sc_bus_priority_get_stats(const sc_bus_t *bus, uint8_t *depths, uint32_t *dropped);
+
 /**
  * @brief Initialize the priority queue system
  * 
- * This function initializes all necessary data structures for the priority queue system,
- * including setting up queues for each priority level.
+ * This function resets the priority queues of the default event bus instance
+ * to their empty state.
  */
 void sc_priority_init(void);
 
@@ -43,6 +183,49 @@ int sc_priority_publish_raw(const uint8_t *event_data, size_t size);
  */
 void sc_priority_process(void);
 
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_DRR
+/**
+ * @brief Set the deficit round robin weight of a priority level
+ * 
+ * @param priority Priority level
+ * @param weight Bytes per round
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_priority_set_weight(uint8_t priority, uint16_t weight);
+#endif
+
+/**
+ * @brief Get the service counters of the priority levels
+ * 
+ * @param served Array of SAFECORE_EVENT_PRIORITIES entries for delivered event counts (may be NULL)
+ * @param max_wait_ms Array of SAFECORE_EVENT_PRIORITIES entries for the longest waits (may be NULL)
+ */
+void sc_priority_get_service(uint32_t *served, uint32_t *max_wait_ms);
+
+#if SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF
+/**
+ * @brief Get the deadline miss counters of the priority levels
+ * 
+ * @param missed Array of SAFECORE_EVENT_PRIORITIES entries for the events delivered late
+ */
+void sc_priority_get_deadline_misses(uint32_t *missed);
+#endif
+
+#if SAFECORE_HISTOGRAM_ENABLED == 1
+/**
+ * @brief Copy the latency and depth histograms
+ * 
+ * @param out Histograms to fill in
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_priority_get_histograms(sc_bus_hist_t *out);
+
+/**
+ * @brief Reset the latency and depth histograms
+ */
+void sc_priority_reset_histograms(void);
+#endif
+
 /* === Priority Publishing Macros === */
 
 /**
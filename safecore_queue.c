@@ -0,0 +1,1284 @@
+/*
+ * safecore_queue.c
+ *
+ * SafeCore Event Queue Implementation
+ * This file implements the ring buffer used by the event bus and the
+ * priority queue module: fixed-slot, lock-free MPSC and variable-length
+ * byte ring variants.
+ */
+#include "safecore_queue.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if SAFECORE_BASIC_ENABLED == 1
+
+#if (SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST) && (SAFECORE_MPSC_ENABLED != 1)
+static int queue_drop_oldest(sc_queue_t *q);
+#endif
+
+/**
+ * @brief Pass an event to the queue hook, if any
+ *
+ * @param q Queue owning the event
+ * @param event Event data
+ * @param size Event size in bytes
+ * @param reason SC_QUEUE_HOOK_TAKEN or SC_QUEUE_HOOK_FREED
+ */
+SAFECORE_INLINE void queue_notify(const sc_queue_t *q, const uint8_t *event, size_t size, uint8_t reason) {
+    if (q->hook != NULL) {
+        q->hook(q->hook_ctx, event, size, reason);
+    }
+}
+
+/**
+ * @brief Handle a push into a full queue
+ *
+ * Applies the configured overflow policy for a producer that could not
+ * obtain a free slot.
+ *
+ * @param q Queue that overflowed
+ * @return int 0 if the push may proceed after dropping the oldest event, -1 if
+ *         the new event is dropped
+ */
+static int queue_overflow(sc_queue_t *q) {
+#if SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_PANIC
+    (void)q;
+    SAFECORE_ON_ERROR("Event queue overflow - PANIC");
+    /* Safety shutdown - infinite loop */
+    for (;;) {
+        /* Safety shutdown */
+    }
+#elif SAFECORE_MPSC_ENABLED == 1
+    /* Producers never move the consumer position: drop the new event */
+    (void)atomic_fetch_add_explicit(&q->dropped, 1U, memory_order_relaxed);
+    return -1;
+#elif SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST
+    q->dropped++;
+    if (q->holding != 0U) {
+        /* Held slots sit at the tail and cannot be evicted: drop the new event */
+        return -1;
+    }
+    return queue_drop_oldest(q);
+#else
+    /* Default policy: drop new event */
+    q->dropped++;
+    return -1;
+#endif
+}
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED != 1
+/**
+ * @brief Get the slot index of a pointer into the slot storage
+ *
+ * @param q Queue owning the slot
+ * @param slot Pointer to the start of a slot
+ * @param out_idx Pointer to store the slot index
+ * @return int 0 if the pointer is the start of a slot of this queue, -1 otherwise
+ */
+static int queue_slot_index(const sc_queue_t *q, const uint8_t *slot, uint32_t *out_idx) {
+    int result = -1;
+
+    if ((q != NULL) && (slot != NULL) && (slot >= q->slots)) {
+        size_t offset = (size_t)(slot - q->slots);
+        if (((offset % q->slot_size) == 0U) && ((offset / q->slot_size) < q->capacity)) {
+            *out_idx = (uint32_t)(offset / q->slot_size);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Initialize a queue over caller-provided storage
+ *
+ * Binds the queue to its slot, size and (in MPSC mode) sequence arrays and
+ * resets it to the empty state.
+ *
+ * @param q Queue to initialize
+ * @param slots Slot storage of capacity * slot_size bytes
+ * @param sizes Per-slot size array
+ * @param seq Per-slot sequence array (MPSC mode only)
+ * @param capacity Number of slots (power of 2)
+ * @param slot_size Maximum event size in bytes
+ * @return int 0 on success, -1 on invalid parameters
+ */
+#if SAFECORE_MPSC_ENABLED == 1
+int sc_queue_init(sc_queue_t *q, uint8_t *slots, uint16_t *sizes, sc_queue_seq_t *seq,
+                  uint16_t capacity, uint16_t slot_size) {
+#else
+int sc_queue_init(sc_queue_t *q, uint8_t *slots, uint16_t *sizes,
+                  uint16_t capacity, uint16_t slot_size) {
+#endif
+    int result = -1;
+
+    if ((q != NULL) && (slots != NULL) && (sizes != NULL) && (slot_size > 0U) &&
+        (capacity > 1U) && ((capacity & (capacity - 1U)) == 0U)) {
+        q->slots = slots;
+        q->sizes = sizes;
+#if SAFECORE_MPSC_ENABLED == 1
+        if (seq == NULL) {
+            return -1;
+        }
+        q->seq = seq;
+#endif
+        q->capacity = capacity;
+        q->slot_size = slot_size;
+        q->hook = NULL;
+        q->hook_ctx = NULL;
+        sc_queue_reset(q);
+        result = 0;
+    }
+
+    return result;
+}
+#endif /* SAFECORE_QUEUE_VARLEN_ENABLED != 1 */
+
+/**
+ * @brief Reset a queue to the empty state
+ *
+ * Resets positions and the drop counter. In MPSC mode every slot sequence is
+ * set to its own index, marking it free for the first lap. In variable-length
+ * mode the ring restarts at offset 0. Pending events are passed to the free
+ * hook first.
+ *
+ * @param q Queue to reset
+ */
+void sc_queue_reset(sc_queue_t *q) {
+    size_t size;
+
+    if (q == NULL) {
+        return;
+    }
+
+    if (q->hook != NULL) {
+        /* Releasing each pending event passes it to the hook */
+        while (sc_queue_pop(q, &size) != NULL) {
+            /* Drain */
+        }
+    }
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+    q->head = 0U;
+    q->tail = 0U;
+    q->used = 0U;
+    q->count = 0U;
+    q->dropped = 0U;
+    q->reserved = 0U;
+    q->staged = 0U;
+#elif SAFECORE_MPSC_ENABLED == 1
+    uint32_t i;
+    /* Every slot starts free for the lap that begins at its own index */
+    for (i = 0U; i < q->capacity; i++) {
+        atomic_init(&q->seq[i], i);
+    }
+    atomic_init(&q->head, 0U);
+    atomic_init(&q->tail, 0U);
+    atomic_init(&q->dropped, 0U);
+#else
+    q->head = 0U;
+    q->tail = 0U;
+    q->dropped = 0U;
+    q->reserved = 0U;
+    q->staged = 0U;
+#endif
+    q->holding = 0U;
+}
+
+/**
+ * @brief Set the hook called when events are taken or freed
+ *
+ * @param q Queue to configure
+ * @param hook Hook function, or NULL to disable
+ * @param ctx Context pointer passed to the hook
+ */
+void sc_queue_set_hook(sc_queue_t *q, sc_queue_hook_t hook, void *ctx) {
+    if (q != NULL) {
+        q->hook = hook;
+        q->hook_ctx = ctx;
+    }
+}
+
+/**
+ * @brief Push an event into the queue
+ *
+ * Reserves the next slot, copies the event into it and commits it.
+ *
+ * @param q Queue to push to
+ * @param data Pointer to the event data to copy
+ * @param size Size of the event data in bytes
+ * @return int 0 on success, -1 on failure (invalid parameters or event dropped)
+ */
+int sc_queue_push(sc_queue_t *q, const uint8_t *data, size_t size) {
+    int result = -1;
+
+    if (data != NULL) {
+        uint8_t *slot = sc_queue_reserve(q, size);
+        if (slot != NULL) {
+            /* Copy event data to queue */
+            (void)memcpy(slot, data, size);
+            result = sc_queue_commit(q, slot);
+        }
+    }
+
+    return result;
+}
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED != 1
+/**
+ * @brief Give up a reserved slot
+ *
+ * Passes the event to the hook, then marks the slot as empty and
+ * commits it, so the consumer skips it.
+ *
+ * @param q Queue the slot was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_discard(sc_queue_t *q, uint8_t *slot) {
+    uint32_t idx;
+    int result = -1;
+
+    if (queue_slot_index(q, slot, &idx) == 0) {
+        queue_notify(q, slot, q->sizes[idx], SC_QUEUE_HOOK_FREED);
+        q->sizes[idx] = 0U;
+        result = sc_queue_commit(q, slot);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check whether a pointer lies in the queue's slot storage
+ *
+ * @param q Queue to check
+ * @param p Pointer to check
+ * @return int 1 if p points into the slot storage, 0 otherwise
+ */
+int sc_queue_owns(const sc_queue_t *q, const uint8_t *p) {
+    return (int)((q != NULL) && (p != NULL) && (p >= q->slots) &&
+                 ((size_t)(p - q->slots) < ((size_t)q->capacity * q->slot_size)));
+}
+
+/**
+ * @brief Get the size a slot was reserved with
+ *
+ * @param q Queue that owns the slot
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return size_t Reserved size in bytes, 0 if the slot is not in the queue
+ */
+size_t sc_queue_reserved_size(const sc_queue_t *q, const uint8_t *slot) {
+    if (sc_queue_owns(q, slot) == 0) {
+        return 0U;
+    }
+
+    return q->sizes[(size_t)(slot - q->slots) / q->slot_size];
+}
+#endif /* SAFECORE_QUEUE_VARLEN_ENABLED != 1 */
+
+/**
+ * @brief Pop the oldest event from the queue
+ *
+ * Releases the slot held from the previous pop, then peeks at the next event.
+ *
+ * @param q Queue to pop from
+ * @param out_size Pointer to store the size of the popped event
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_queue_pop(sc_queue_t *q, size_t *out_size) {
+    /* Hand the previously popped slot back to producers */
+    sc_queue_release(q);
+    return sc_queue_peek(q, out_size);
+}
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+
+/**
+ * @brief Get the record header at a ring offset
+ *
+ * @param q Queue owning the ring
+ * @param offset Record offset (multiple of SC_QUEUE_RECORD_ALIGN)
+ * @return sc_queue_record_t* Pointer to the record header
+ */
+SAFECORE_INLINE sc_queue_record_t* queue_record_at(const sc_queue_t *q, uint32_t offset) {
+    return (sc_queue_record_t*)(void*)&q->buf[offset];
+}
+
+/**
+ * @brief Skip wrap padding at the tail
+ *
+ * @param q Queue to advance
+ */
+static void queue_skip_pad(sc_queue_t *q) {
+    if ((q->used > 0U) && ((queue_record_at(q, q->tail)->flags & SC_QUEUE_REC_PAD) != 0U)) {
+        q->used -= q->bytes - q->tail;
+        q->tail = 0U;
+    }
+}
+
+/**
+ * @brief Free the record at the tail
+ *
+ * Passes the event to the hook unless it was discarded.
+ *
+ * @param q Queue to free the oldest record of
+ */
+static void queue_free_tail(sc_queue_t *q) {
+    const sc_queue_record_t *rec = queue_record_at(q, q->tail);
+    uint32_t n = (uint32_t)SC_QUEUE_RECORD_BYTES(rec->len);
+
+    if ((rec->flags & SC_QUEUE_REC_DISCARD) == 0U) {
+        queue_notify(q, &q->buf[q->tail + (uint32_t)sizeof(sc_queue_record_t)], rec->len,
+                     SC_QUEUE_HOOK_FREED);
+    }
+
+    q->tail += n;
+    if (q->tail >= q->bytes) {
+        q->tail = 0U;
+    }
+    q->used -= n;
+    q->count--;
+}
+
+#if SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST
+/**
+ * @brief Evict the oldest record to make room for a new one
+ *
+ * @param q Queue to evict from
+ * @return int 0 if a record was evicted, -1 if the queue holds no record
+ */
+static int queue_drop_oldest(sc_queue_t *q) {
+    if (q->count == 0U) {
+        return -1;
+    }
+    queue_skip_pad(q);
+    queue_free_tail(q);
+    return 0;
+}
+#endif
+
+/**
+ * @brief Initialize a variable-length queue over a caller-provided byte ring
+ *
+ * @param q Queue to initialize
+ * @param buf Byte ring storage, aligned to SC_QUEUE_RECORD_ALIGN
+ * @param bytes Ring size in bytes (multiple of SC_QUEUE_RECORD_ALIGN)
+ * @param max_size Maximum event size in bytes
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_init(sc_queue_t *q, uint8_t *buf, uint32_t bytes, uint16_t max_size) {
+    int result = -1;
+
+    if ((q != NULL) && (buf != NULL) && (max_size > 0U) &&
+        ((bytes % SC_QUEUE_RECORD_ALIGN) == 0U) &&
+        (bytes >= SC_QUEUE_RECORD_BYTES(max_size))) {
+        q->buf = buf;
+        q->bytes = bytes;
+        q->capacity = 0U;
+        q->slot_size = max_size;
+        q->hook = NULL;
+        q->hook_ctx = NULL;
+        sc_queue_reset(q);
+        result = 0;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Claim room for a record at the head of the ring
+ *
+ * Pads to the end of the ring when the record does not fit before the wrap
+ * point, so payloads are always contiguous. Overflow is handled according to
+ * the configured policy; DROP_OLDEST evicts as many published records as
+ * needed.
+ *
+ * @param q Queue to claim in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the payload, or NULL on failure
+ */
+static uint8_t* queue_claim(sc_queue_t *q, size_t size) {
+    uint32_t need;
+    uint32_t pad;
+
+    /* Validate input parameters */
+    if ((size == 0U) || (size > q->slot_size)) {
+        return NULL;
+    }
+
+    need = (uint32_t)SC_QUEUE_RECORD_BYTES(size);
+    for (;;) {
+        if ((q->used == 0U) && (q->holding == 0U)) {
+            /* Empty ring: restart at the beginning to avoid padding */
+            q->head = 0U;
+            q->tail = 0U;
+        }
+        pad = ((q->head + need) > q->bytes) ? (q->bytes - q->head) : 0U;
+        if ((q->bytes - q->used) >= (pad + need)) {
+            break;
+        }
+        /* Handle queue overflow according to configured policy */
+        if (queue_overflow(q) != 0) {
+            return NULL;
+        }
+    }
+
+    if (pad != 0U) {
+        /* Fill the tail end of the ring and wrap */
+        queue_record_at(q, q->head)->len = 0U;
+        queue_record_at(q, q->head)->flags = SC_QUEUE_REC_PAD;
+        q->used += pad;
+        q->head = 0U;
+    }
+
+    queue_record_at(q, q->head)->len = (uint16_t)size;
+    queue_record_at(q, q->head)->flags = 0U;
+    return &q->buf[q->head + (uint32_t)sizeof(sc_queue_record_t)];
+}
+
+/**
+ * @brief Move the head past the record claimed at it
+ *
+ * @param q Queue to advance
+ */
+static void queue_advance_head(sc_queue_t *q) {
+    uint32_t n = (uint32_t)SC_QUEUE_RECORD_BYTES(queue_record_at(q, q->head)->len);
+
+    q->used += n;
+    q->head += n;
+    if (q->head >= q->bytes) {
+        q->head = 0U;
+    }
+}
+
+/**
+ * @brief Reserve room for a record at the head of the ring
+ *
+ * @param q Queue to reserve in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the payload, or NULL on failure
+ */
+uint8_t* sc_queue_reserve(sc_queue_t *q, size_t size) {
+    uint8_t *slot = NULL;
+
+    if ((q != NULL) && (q->reserved == 0U) && (q->staged == 0U)) {
+        slot = queue_claim(q, size);
+        if (slot != NULL) {
+            q->reserved = 1U;
+        }
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Claim a record as part of a batch
+ *
+ * The record is written past the head right away but becomes visible to the
+ * consumer only when sc_queue_publish() adds the batch to the record count.
+ *
+ * @param q Queue to stage in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the payload, or NULL on failure
+ */
+uint8_t* sc_queue_stage(sc_queue_t *q, size_t size) {
+    uint8_t *slot = NULL;
+
+    if ((q != NULL) && (q->reserved == 0U)) {
+        slot = queue_claim(q, size);
+        if (slot != NULL) {
+            queue_advance_head(q);
+            q->staged++;
+        }
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Publish all staged records
+ *
+ * @param q Queue to publish
+ */
+void sc_queue_publish(sc_queue_t *q) {
+    if (q != NULL) {
+        q->count = (uint16_t)(q->count + q->staged);
+        q->staged = 0U;
+    }
+}
+
+/**
+ * @brief Commit the record reserved at the head of the ring
+ *
+ * @param q Queue the record was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_commit(sc_queue_t *q, uint8_t *slot) {
+    int result = -1;
+
+    if ((q != NULL) && (q->reserved != 0U) &&
+        (slot == &q->buf[q->head + (uint32_t)sizeof(sc_queue_record_t)])) {
+        queue_advance_head(q);
+        q->count++;
+        q->reserved = 0U;
+        result = 0;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Give up the record reserved at the head of the ring
+ *
+ * Passes the event to the hook, then commits the record flagged as
+ * discarded, so the consumer skips it.
+ *
+ * @param q Queue the record was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_discard(sc_queue_t *q, uint8_t *slot) {
+    int result = -1;
+
+    if ((q != NULL) && (q->reserved != 0U) &&
+        (slot == &q->buf[q->head + (uint32_t)sizeof(sc_queue_record_t)])) {
+        queue_notify(q, slot, queue_record_at(q, q->head)->len, SC_QUEUE_HOOK_FREED);
+        queue_record_at(q, q->head)->flags = SC_QUEUE_REC_DISCARD;
+        result = sc_queue_commit(q, slot);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check whether a pointer lies in the queue's byte ring
+ *
+ * @param q Queue to check
+ * @param p Pointer to check
+ * @return int 1 if p points into the ring, 0 otherwise
+ */
+int sc_queue_owns(const sc_queue_t *q, const uint8_t *p) {
+    return (int)((q != NULL) && (p != NULL) && (p >= q->buf) &&
+                 ((size_t)(p - q->buf) < q->bytes));
+}
+
+/**
+ * @brief Get the size a record was reserved with
+ *
+ * @param q Queue that owns the record
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return size_t Reserved size in bytes, 0 if the record is not in the queue
+ */
+size_t sc_queue_reserved_size(const sc_queue_t *q, const uint8_t *slot) {
+    if ((sc_queue_owns(q, slot) == 0) || ((size_t)(slot - q->buf) < sizeof(sc_queue_record_t))) {
+        return 0U;
+    }
+
+    return ((const sc_queue_record_t *)(const void *)(slot - sizeof(sc_queue_record_t)))->len;
+}
+
+/**
+ * @brief Look at the oldest record
+ *
+ * Skips wrap padding and discarded records. The record stays owned by the
+ * consumer until it is released.
+ *
+ * @param q Queue to peek at
+ * @param out_size Pointer to store the size of the event
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_queue_peek(sc_queue_t *q, size_t *out_size) {
+    const uint8_t *e = NULL;
+
+    if ((q != NULL) && (out_size != NULL)) {
+        while (q->count > 0U) {
+            const sc_queue_record_t *rec;
+
+            queue_skip_pad(q);
+            rec = queue_record_at(q, q->tail);
+            if (q->holding == 0U) {
+                q->holding = 1U;
+            }
+            if ((rec->flags & SC_QUEUE_REC_DISCARD) == 0U) {
+                *out_size = rec->len;
+                e = &q->buf[q->tail + (uint32_t)sizeof(sc_queue_record_t)];
+                queue_notify(q, e, *out_size, SC_QUEUE_HOOK_TAKEN);
+                break;
+            }
+            /* Discarded reservation: skip it */
+            sc_queue_release(q);
+        }
+    }
+
+    return e;
+}
+
+/**
+ * @brief Look at several of the oldest records
+ *
+ * Walks the published records from the tail, skipping padding and discarded
+ * records. All walked records stay owned by the consumer until released.
+ *
+ * @param q Queue to peek at
+ * @param events Array to receive up to max event pointers
+ * @param sizes Array to receive the event sizes
+ * @param max Maximum number of events to return
+ * @return uint16_t Number of events returned
+ */
+uint16_t sc_queue_peek_batch(sc_queue_t *q, const uint8_t *events[], size_t sizes[], uint16_t max) {
+    uint16_t n = 0U;
+
+    if ((q == NULL) || (events == NULL) || (sizes == NULL) || (max == 0U) || (q->holding != 0U)) {
+        return 0U;
+    }
+
+    events[0] = sc_queue_peek(q, &sizes[0]);
+    if (events[0] != NULL) {
+        uint32_t offset = q->tail;
+        n = 1U;
+
+        while ((n < max) && (q->holding < q->count)) {
+            const sc_queue_record_t *rec;
+
+            offset += (uint32_t)SC_QUEUE_RECORD_BYTES(queue_record_at(q, offset)->len);
+            if (offset >= q->bytes) {
+                offset = 0U;
+            }
+            rec = queue_record_at(q, offset);
+            if ((rec->flags & SC_QUEUE_REC_PAD) != 0U) {
+                offset = 0U;
+                rec = queue_record_at(q, offset);
+            }
+            q->holding++;
+            if ((rec->flags & SC_QUEUE_REC_DISCARD) == 0U) {
+                events[n] = &q->buf[offset + (uint32_t)sizeof(sc_queue_record_t)];
+                sizes[n] = rec->len;
+                queue_notify(q, events[n], sizes[n], SC_QUEUE_HOOK_TAKEN);
+                n++;
+            }
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Release the records held by the consumer
+ *
+ * @param q Queue to release the records of
+ */
+void sc_queue_release(sc_queue_t *q) {
+    if (q != NULL) {
+        while (q->holding != 0U) {
+            queue_skip_pad(q);
+            queue_free_tail(q);
+            q->holding--;
+        }
+    }
+}
+
+/**
+ * @brief Get the number of records in the queue
+ *
+ * @param q Queue to query
+ * @return uint16_t Number of queued records
+ */
+uint16_t sc_queue_depth(const sc_queue_t *q) {
+    return (q != NULL) ? q->count : 0U;
+}
+
+/**
+ * @brief Get the number of events dropped on overflow
+ *
+ * @param q Queue to query
+ * @return uint32_t Number of dropped events
+ */
+uint32_t sc_queue_dropped(const sc_queue_t *q) {
+    return (q != NULL) ? q->dropped : 0U;
+}
+
+/**
+ * @brief Get the number of maximum-size records the ring holds
+ *
+ * @param q Queue to query
+ * @return uint16_t Capacity in records
+ */
+uint16_t sc_queue_capacity(const sc_queue_t *q) {
+    uint32_t n = 0U;
+
+    if ((q != NULL) && (q->slot_size > 0U)) {
+        n = q->bytes / (uint32_t)SC_QUEUE_RECORD_BYTES(q->slot_size);
+    }
+
+    return (n > 0xFFFFU) ? 0xFFFFU : (uint16_t)n;
+}
+
+/**
+ * @brief Check whether a record fits without overflow handling
+ *
+ * Accounts for the padding needed when the record does not fit before
+ * the end of the ring.
+ *
+ * @param q Queue to check
+ * @param size Size of the event in bytes
+ * @return int 1 if the record fits, 0 otherwise
+ */
+int sc_queue_can_push(const sc_queue_t *q, size_t size) {
+    uint32_t need;
+    uint32_t pad;
+
+    if ((q == NULL) || (size == 0U) || (size > q->slot_size) || (q->reserved != 0U) ||
+        (q->staged != 0U)) {
+        return 0;
+    }
+
+    need = (uint32_t)SC_QUEUE_RECORD_BYTES(size);
+    if ((q->used == 0U) && (q->holding == 0U)) {
+        /* Claiming restarts an empty ring at the beginning */
+        return (q->bytes >= need) ? 1 : 0;
+    }
+    pad = ((q->head + need) > q->bytes) ? (q->bytes - q->head) : 0U;
+
+    return ((q->bytes - q->used) >= (pad + need)) ? 1 : 0;
+}
+
+#elif SAFECORE_MPSC_ENABLED == 1
+
+/**
+ * @brief Reserve a slot (lock-free MPSC)
+ *
+ * Claims a position by CAS on the head. The slot is published to the
+ * consumer by sc_queue_commit().
+ *
+ * @param q Queue to reserve in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure (invalid parameters or queue full)
+ */
+uint8_t* sc_queue_reserve(sc_queue_t *q, size_t size) {
+    if ((q == NULL) || (size == 0U) || (size > q->slot_size)) {
+        return NULL;
+    }
+
+    const uint32_t mask = (uint32_t)q->capacity - 1U;
+    uint32_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(&q->seq[pos & mask], memory_order_acquire);
+        int32_t dif = (int32_t)(seq - pos);
+
+        if (dif == 0) {
+            /* Slot is free for this lap: try to claim the position */
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1U,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+            /* pos was reloaded by the failed CAS */
+        } else if (dif < 0) {
+            /* Slot still holds an event from the previous lap: queue full */
+            (void)queue_overflow(q);
+            return NULL;
+        } else {
+            /* Another producer claimed this position, catch up */
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+
+    /* Position claimed: the producer owns the slot until commit */
+    uint32_t idx = pos & mask;
+    q->sizes[idx] = (uint16_t)size;
+    return &q->slots[(size_t)idx * q->slot_size];
+}
+
+/**
+ * @brief Commit a reserved slot (lock-free MPSC)
+ *
+ * Publishes the slot by storing its sequence with release ordering. A
+ * claimed slot still carries the sequence of the position it was claimed at.
+ *
+ * @param q Queue the slot was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_commit(sc_queue_t *q, uint8_t *slot) {
+    uint32_t idx;
+    int result = -1;
+
+    if (queue_slot_index(q, slot, &idx) == 0) {
+        uint32_t pos = atomic_load_explicit(&q->seq[idx], memory_order_relaxed);
+        atomic_store_explicit(&q->seq[idx], pos + 1U, memory_order_release);
+        result = 0;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Look at the oldest event (single consumer)
+ *
+ * Returns the slot at the tail if its producer has committed it, skipping
+ * discarded reservations. The slot stays owned by the consumer until it is
+ * released.
+ *
+ * @param q Queue to peek at
+ * @param out_size Pointer to store the size of the event
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_queue_peek(sc_queue_t *q, size_t *out_size) {
+    const uint8_t *e = NULL;
+
+    if ((q != NULL) && (out_size != NULL)) {
+        const uint32_t mask = (uint32_t)q->capacity - 1U;
+
+        for (;;) {
+            uint32_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+            uint32_t seq = atomic_load_explicit(&q->seq[pos & mask], memory_order_acquire);
+
+            /* A committed slot carries pos + 1; anything older is empty or still being written */
+            if ((int32_t)(seq - (pos + 1U)) < 0) {
+                break;
+            }
+
+            uint32_t idx = pos & mask;
+            if (q->holding == 0U) {
+                q->holding = 1U;
+            }
+            if (q->sizes[idx] != 0U) {
+                *out_size = q->sizes[idx];
+                e = &q->slots[(size_t)idx * q->slot_size];
+                queue_notify(q, e, *out_size, SC_QUEUE_HOOK_TAKEN);
+                break;
+            }
+            /* Discarded reservation: skip it */
+            sc_queue_release(q);
+        }
+    }
+
+    return e;
+}
+
+/**
+ * @brief Look at several of the oldest events (single consumer)
+ *
+ * Walks committed slots from the tail up to the first slot still being
+ * written, skipping discarded reservations. All walked slots stay owned by
+ * the consumer until released.
+ *
+ * @param q Queue to peek at
+ * @param events Array to receive up to max event pointers
+ * @param sizes Array to receive the event sizes
+ * @param max Maximum number of events to return
+ * @return uint16_t Number of events returned
+ */
+uint16_t sc_queue_peek_batch(sc_queue_t *q, const uint8_t *events[], size_t sizes[], uint16_t max) {
+    uint16_t n = 0U;
+
+    if ((q == NULL) || (events == NULL) || (sizes == NULL) || (max == 0U) || (q->holding != 0U)) {
+        return 0U;
+    }
+
+    events[0] = sc_queue_peek(q, &sizes[0]);
+    if (events[0] != NULL) {
+        const uint32_t mask = (uint32_t)q->capacity - 1U;
+        uint32_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed) + 1U;
+        n = 1U;
+
+        while ((n < max) && (q->holding < q->capacity)) {
+            uint32_t seq = atomic_load_explicit(&q->seq[pos & mask], memory_order_acquire);
+            uint32_t idx = pos & mask;
+
+            if ((int32_t)(seq - (pos + 1U)) < 0) {
+                break; /* Not committed yet */
+            }
+            q->holding++;
+            if (q->sizes[idx] != 0U) {
+                events[n] = &q->slots[(size_t)idx * q->slot_size];
+                sizes[n] = q->sizes[idx];
+                queue_notify(q, events[n], sizes[n], SC_QUEUE_HOOK_TAKEN);
+                n++;
+            }
+            pos++;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Release the slots held by the consumer
+ *
+ * Marks each slot free for the next lap and advances the consumer position.
+ *
+ * @param q Queue to release the slots of
+ */
+void sc_queue_release(sc_queue_t *q) {
+    while ((q != NULL) && (q->holding != 0U)) {
+        const uint32_t mask = (uint32_t)q->capacity - 1U;
+        uint32_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        uint32_t idx = pos & mask;
+
+        if (q->sizes[idx] != 0U) {
+            queue_notify(q, &q->slots[(size_t)idx * q->slot_size], q->sizes[idx],
+                         SC_QUEUE_HOOK_FREED);
+        }
+
+        /* Mark the slot free for the next lap */
+        atomic_store_explicit(&q->seq[idx], pos + (uint32_t)q->capacity,
+                              memory_order_release);
+        atomic_store_explicit(&q->tail, pos + 1U, memory_order_relaxed);
+        q->holding--;
+    }
+}
+
+/**
+ * @brief Get the number of events in the queue
+ *
+ * The value is a snapshot; producers may be claiming slots concurrently.
+ *
+ * @param q Queue to query
+ * @return uint16_t Number of queued events
+ */
+uint16_t sc_queue_depth(const sc_queue_t *q) {
+    uint16_t depth = 0U;
+
+    if (q != NULL) {
+        uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+        uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        uint32_t used = head - tail;
+
+        /* Claimed but uncommitted slots count as queued */
+        depth = (used > q->capacity) ? q->capacity : (uint16_t)used;
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Get the number of events dropped on overflow
+ *
+ * @param q Queue to query
+ * @return uint32_t Number of dropped events
+ */
+uint32_t sc_queue_dropped(const sc_queue_t *q) {
+    return (q != NULL) ? atomic_load_explicit(&q->dropped, memory_order_relaxed) : 0U;
+}
+
+/**
+ * @brief Get the number of events the queue holds
+ *
+ * @param q Queue to query
+ * @return uint16_t Capacity in events, every slot is usable
+ */
+uint16_t sc_queue_capacity(const sc_queue_t *q) {
+    return (q != NULL) ? q->capacity : 0U;
+}
+
+/**
+ * @brief Check whether an event fits without overflow handling
+ *
+ * @param q Queue to check
+ * @param size Size of the event in bytes
+ * @return int 1 if a slot is free, 0 otherwise
+ */
+int sc_queue_can_push(const sc_queue_t *q, size_t size) {
+    if ((q == NULL) || (size == 0U) || (size > q->slot_size)) {
+        return 0;
+    }
+
+    return (sc_queue_depth(q) < q->capacity) ? 1 : 0;
+}
+
+#else /* fixed-slot single producer */
+
+/**
+ * @brief Check if a queue is full
+ *
+ * @param q Queue to check
+ * @return uint8_t 1 if the queue is full, 0 otherwise
+ */
+SAFECORE_INLINE uint8_t queue_full(const sc_queue_t *q) {
+    /* Using unsigned suffix to avoid integer overflow */
+    return (uint8_t)(((q->head + 1U) & (q->capacity - 1U)) == q->tail);
+}
+
+/**
+ * @brief Check if a queue is empty
+ *
+ * @param q Queue to check
+ * @return uint8_t 1 if the queue is empty, 0 otherwise
+ */
+SAFECORE_INLINE uint8_t queue_empty(const sc_queue_t *q) {
+    return (uint8_t)(q->head == q->tail);
+}
+
+/**
+ * @brief Free the slot at the tail
+ *
+ * Passes the event to the hook unless it was discarded, then advances
+ * the tail.
+ *
+ * @param q Queue to free the oldest slot of
+ */
+static void queue_free_slot(sc_queue_t *q) {
+    if (q->sizes[q->tail] != 0U) {
+        queue_notify(q, &q->slots[(size_t)q->tail * q->slot_size], q->sizes[q->tail],
+                     SC_QUEUE_HOOK_FREED);
+    }
+    /* Update tail pointer with wrap-around */
+    q->tail = (uint16_t)((q->tail + 1U) & (q->capacity - 1U));
+}
+
+#if SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST
+/**
+ * @brief Drop the oldest event to make room for a new one
+ *
+ * @param q Queue to drop from
+ * @return int 0, the head slot is free afterwards
+ */
+static int queue_drop_oldest(sc_queue_t *q) {
+    /* Drop oldest event by advancing tail */
+    queue_free_slot(q);
+    return 0;
+}
+#endif
+
+/**
+ * @brief Reserve the slot at the head of the queue
+ *
+ * Handles overflow according to the configured policy and returns the head
+ * slot. The head advances on commit.
+ *
+ * @param q Queue to reserve in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure
+ */
+uint8_t* sc_queue_reserve(sc_queue_t *q, size_t size) {
+    /* Validate input parameters */
+    if ((q == NULL) || (size == 0U) || (size > q->slot_size) || (q->reserved != 0U) ||
+        (q->staged != 0U)) {
+        return NULL;
+    }
+
+    /* Handle queue overflow according to configured policy */
+    if (queue_full(q) && (queue_overflow(q) != 0)) {
+        return NULL;
+    }
+
+    q->sizes[q->head] = (uint16_t)size;
+    q->reserved = 1U;
+    return &q->slots[(size_t)q->head * q->slot_size];
+}
+
+/**
+ * @brief Claim the next slot as part of a batch
+ *
+ * Staged slots follow the head and become visible to the consumer only when
+ * sc_queue_publish() moves the head past all of them at once. DROP_OLDEST
+ * evicts published events only.
+ *
+ * @param q Queue to stage in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure
+ */
+uint8_t* sc_queue_stage(sc_queue_t *q, size_t size) {
+    if ((q == NULL) || (size == 0U) || (size > q->slot_size) || (q->reserved != 0U)) {
+        return NULL;
+    }
+
+    uint16_t pos = (uint16_t)((q->head + q->staged) & (q->capacity - 1U));
+    if (((pos + 1U) & (q->capacity - 1U)) == q->tail) {
+#if SAFECORE_QUEUE_OVERFLOW_POLICY == SAFECORE_QUEUE_DROP_OLDEST
+        if (queue_empty(q)) {
+            /* Only staged events left: nothing published to evict */
+            q->dropped++;
+            return NULL;
+        }
+#endif
+        if (queue_overflow(q) != 0) {
+            return NULL;
+        }
+    }
+
+    q->sizes[pos] = (uint16_t)size;
+    q->staged++;
+    return &q->slots[(size_t)pos * q->slot_size];
+}
+
+/**
+ * @brief Publish all staged slots with a single head update
+ *
+ * @param q Queue to publish
+ */
+void sc_queue_publish(sc_queue_t *q) {
+    if ((q != NULL) && (q->staged != 0U)) {
+        q->head = (uint16_t)((q->head + q->staged) & (q->capacity - 1U));
+        q->staged = 0U;
+    }
+}
+
+/**
+ * @brief Commit the slot reserved at the head of the queue
+ *
+ * @param q Queue the slot was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_commit(sc_queue_t *q, uint8_t *slot) {
+    uint32_t idx;
+    int result = -1;
+
+    if ((queue_slot_index(q, slot, &idx) == 0) && (q->reserved != 0U) && (idx == q->head)) {
+        /* Update head pointer with wrap-around */
+        q->head = (uint16_t)((q->head + 1U) & (q->capacity - 1U));
+        q->reserved = 0U;
+        result = 0;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Look at the oldest event
+ *
+ * Returns the event at the tail without removing it, skipping discarded
+ * reservations. The slot stays owned by the consumer until it is released.
+ *
+ * @param q Queue to peek at
+ * @param out_size Pointer to store the size of the event
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_queue_peek(sc_queue_t *q, size_t *out_size) {
+    const uint8_t *e = NULL;
+
+    if ((q != NULL) && (out_size != NULL)) {
+        while (!queue_empty(q)) {
+            if (q->holding == 0U) {
+                q->holding = 1U;
+            }
+            if (q->sizes[q->tail] != 0U) {
+                *out_size = q->sizes[q->tail];
+                e = &q->slots[(size_t)q->tail * q->slot_size];
+                queue_notify(q, e, *out_size, SC_QUEUE_HOOK_TAKEN);
+                break;
+            }
+            /* Discarded reservation: skip it */
+            sc_queue_release(q);
+        }
+    }
+
+    return e;
+}
+
+/**
+ * @brief Look at several of the oldest events
+ *
+ * Walks published slots from the tail, skipping discarded reservations. All
+ * walked slots stay owned by the consumer until released.
+ *
+ * @param q Queue to peek at
+ * @param events Array to receive up to max event pointers
+ * @param sizes Array to receive the event sizes
+ * @param max Maximum number of events to return
+ * @return uint16_t Number of events returned
+ */
+uint16_t sc_queue_peek_batch(sc_queue_t *q, const uint8_t *events[], size_t sizes[], uint16_t max) {
+    uint16_t n = 0U;
+
+    if ((q == NULL) || (events == NULL) || (sizes == NULL) || (max == 0U) || (q->holding != 0U)) {
+        return 0U;
+    }
+
+    events[0] = sc_queue_peek(q, &sizes[0]);
+    if (events[0] != NULL) {
+        uint16_t idx = (uint16_t)((q->tail + 1U) & (q->capacity - 1U));
+        n = 1U;
+
+        while ((n < max) && (idx != q->head)) {
+            q->holding++;
+            if (q->sizes[idx] != 0U) {
+                events[n] = &q->slots[(size_t)idx * q->slot_size];
+                sizes[n] = q->sizes[idx];
+                queue_notify(q, events[n], sizes[n], SC_QUEUE_HOOK_TAKEN);
+                n++;
+            }
+            idx = (uint16_t)((idx + 1U) & (q->capacity - 1U));
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Release the slots held by the consumer
+ *
+ * Removes the held events by advancing the tail.
+ *
+ * @param q Queue to release the slots of
+ */
+void sc_queue_release(sc_queue_t *q) {
+    if (q != NULL) {
+        while (q->holding != 0U) {
+            queue_free_slot(q);
+            q->holding--;
+        }
+    }
+}
+
+/**
+ * @brief Get the number of events in the queue
+ *
+ * @param q Queue to query
+ * @return uint16_t Number of queued events
+ */
+uint16_t sc_queue_depth(const sc_queue_t *q) {
+    uint16_t depth = 0U;
+
+    if (q != NULL) {
+        /* Use unsigned arithmetic to avoid sign issues */
+        depth = (uint16_t)((q->head - q->tail) & (q->capacity - 1U));
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Get the number of events dropped on overflow
+ *
+ * @param q Queue to query
+ * @return uint32_t Number of dropped events
+ */
+uint32_t sc_queue_dropped(const sc_queue_t *q) {
+    return (q != NULL) ? q->dropped : 0U;
+}
+
+/**
+ * @brief Get the number of events the queue holds
+ *
+ * @param q Queue to query
+ * @return uint16_t Capacity in events, one slot less than the ring
+ */
+uint16_t sc_queue_capacity(const sc_queue_t *q) {
+    return ((q != NULL) && (q->capacity > 0U)) ? (uint16_t)(q->capacity - 1U) : 0U;
+}
+
+/**
+ * @brief Check whether an event fits without overflow handling
+ *
+ * @param q Queue to check
+ * @param size Size of the event in bytes
+ * @return int 1 if a slot is free, 0 otherwise
+ */
+int sc_queue_can_push(const sc_queue_t *q, size_t size) {
+    if ((q == NULL) || (size == 0U) || (size > q->slot_size) || (q->reserved != 0U) ||
+        (q->staged != 0U)) {
+        return 0;
+    }
+
+    return (queue_full(q) == 0U) ? 1 : 0;
+}
+
+#endif /* SAFECORE_QUEUE_VARLEN_ENABLED / SAFECORE_MPSC_ENABLED */
+
+#endif /* SAFECORE_BASIC_ENABLED */
@@ -0,0 +1,351 @@
+/*
+ * safecore_queue.h
+ *
+ * SafeCore Event Queue Interface
+ * This file defines the fixed-slot ring buffer shared by the event bus and
+ * the priority queue module. With SAFECORE_MPSC_ENABLED the ring is a
+ * lock-free multi-producer/single-consumer queue built on C11 atomics with
+ * per-slot sequence numbers, so ISRs and threads may publish concurrently
+ * while a single context processes events.
+ *
+ * Producers may build events in place with sc_queue_reserve() and
+ * sc_queue_commit(); the consumer reads events in place with
+ * sc_queue_peek() and sc_queue_release(), so no event is copied between
+ * the producer and the subscribers.
+ *
+ * With SAFECORE_QUEUE_VARLEN_ENABLED the queue is a byte ring that stores
+ * [header][payload] records back to back, padding at the wrap point, so
+ * memory scales with the bytes actually queued rather than with the
+ * largest event.
+ */
+#ifndef SAFECORE_QUEUE_H
+#define SAFECORE_QUEUE_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include <stddef.h>
+
+#if SAFECORE_BASIC_ENABLED == 1
+
+#if SAFECORE_MPSC_ENABLED == 1
+#include <stdatomic.h>
+
+/**
+ * @brief Per-slot sequence number type (MPSC mode only)
+ *
+ * A slot whose sequence equals the producer position is free, one whose
+ * sequence equals position + 1 holds a committed event.
+ */
+typedef _Atomic uint32_t sc_queue_seq_t;
+#endif
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+/**
+ * @brief Variable-length record header
+ *
+ * Precedes every record in the byte ring. Records start on
+ * SC_QUEUE_RECORD_ALIGN boundaries so event structures stay aligned.
+ */
+typedef struct {
+    uint16_t len;                   /* Payload length in bytes */
+    uint16_t flags;                 /* SC_QUEUE_REC_* flags */
+} sc_queue_record_t;
+
+#define SC_QUEUE_RECORD_ALIGN       4U
+#define SC_QUEUE_REC_PAD            0x0001U /* Filler up to the end of the ring */
+#define SC_QUEUE_REC_DISCARD        0x0002U /* Discarded reservation */
+
+/**
+ * @brief Ring bytes taken by a record with the given payload length
+ */
+#define SC_QUEUE_RECORD_BYTES(len) \
+    ((((size_t)(len) + sizeof(sc_queue_record_t)) + (SC_QUEUE_RECORD_ALIGN - 1U)) & \
+     ~((size_t)SC_QUEUE_RECORD_ALIGN - 1U))
+#endif
+
+/**
+ * @brief Queue event hook
+ *
+ * Called with SC_QUEUE_HOOK_TAKEN when the consumer takes an event with a
+ * peek, and with SC_QUEUE_HOOK_FREED when a slot holding an event is
+ * released by the consumer, evicted on overflow, discarded or dropped by
+ * sc_queue_reset(). Lets events that own resources (such as pool handles)
+ * give them back exactly once. TAKEN may be reported more than once for an
+ * event that is peeked repeatedly.
+ */
+typedef void (*sc_queue_hook_t)(void *ctx, const uint8_t *event, size_t size, uint8_t reason);
+
+#define SC_QUEUE_HOOK_TAKEN         0U  /* Event handed to the consumer */
+#define SC_QUEUE_HOOK_FREED         1U  /* Event slot freed */
+
+/**
+ * @brief Event ring buffer
+ *
+ * The queue does not own its storage. In fixed-slot mode the caller provides
+ * the slot array, the per-slot size array and, in MPSC mode, the sequence
+ * array. In variable-length mode the caller provides one byte ring.
+ */
+typedef struct {
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+    uint8_t *buf;                   /* Byte ring storage */
+    uint32_t bytes;                 /* Ring size in bytes */
+    volatile uint32_t head;         /* Write offset */
+    volatile uint32_t tail;         /* Read offset */
+    volatile uint32_t used;         /* Bytes in use, including wrap padding */
+    uint32_t dropped;               /* Number of dropped events */
+    uint16_t count;                 /* Number of published records */
+    uint16_t staged;                /* Records written by sc_queue_stage(), not yet published */
+    uint8_t reserved;               /* Producer holds a reservation at head */
+#elif SAFECORE_MPSC_ENABLED == 1
+    uint8_t *slots;                 /* capacity * slot_size bytes of event storage */
+    uint16_t *sizes;                /* Size of the event held in each slot */
+    sc_queue_seq_t *seq;            /* Per-slot sequence numbers */
+    _Atomic uint32_t head;          /* Producer position (claimed by CAS) */
+    _Atomic uint32_t tail;          /* Consumer position */
+    _Atomic uint32_t dropped;       /* Number of dropped events */
+#else
+    uint8_t *slots;                 /* capacity * slot_size bytes of event storage */
+    uint16_t *sizes;                /* Size of the event held in each slot */
+    volatile uint16_t head;         /* Queue head index */
+    volatile uint16_t tail;         /* Queue tail index */
+    uint32_t dropped;               /* Number of dropped events */
+    uint16_t staged;                /* Slots claimed by sc_queue_stage(), not yet published */
+    uint8_t reserved;               /* Producer holds a reservation at head */
+#endif
+    sc_queue_hook_t hook;           /* Called when events are taken or freed (may be NULL) */
+    void *hook_ctx;                 /* Context passed to the hook */
+    uint16_t holding;               /* Number of slots held by the consumer from the tail */
+    uint16_t capacity;              /* Number of slots (power of 2), unused in variable-length mode */
+    uint16_t slot_size;             /* Maximum event size */
+} sc_queue_t;
+
+/**
+ * @brief Initialize a queue over caller-provided storage
+ *
+ * @param q Queue to initialize
+ * @param slots Slot storage of capacity * slot_size bytes
+ * @param sizes Per-slot size array of capacity entries
+ * @param seq Per-slot sequence array of capacity entries (MPSC mode only)
+ * @param capacity Number of slots, must be a power of 2
+ * @param slot_size Maximum event size in bytes
+ * @return int 0 on success, -1 on invalid parameters
+ *
+ * In variable-length mode the queue takes a byte ring instead: buf/bytes,
+ * where bytes is a multiple of SC_QUEUE_RECORD_ALIGN large enough for one
+ * record of max_size bytes.
+ */
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+int sc_queue_init(sc_queue_t *q, uint8_t *buf, uint32_t bytes, uint16_t max_size);
+#elif SAFECORE_MPSC_ENABLED == 1
+int sc_queue_init(sc_queue_t *q, uint8_t *slots, uint16_t *sizes, sc_queue_seq_t *seq,
+                  uint16_t capacity, uint16_t slot_size);
+#else
+int sc_queue_init(sc_queue_t *q, uint8_t *slots, uint16_t *sizes,
+                  uint16_t capacity, uint16_t slot_size);
+#endif
+
+/**
+ * @brief Reset a queue to the empty state
+ *
+ * Pending events are passed to the hook, if any. Must not be called
+ * while producers are active.
+ *
+ * @param q Queue to reset
+ */
+void sc_queue_reset(sc_queue_t *q);
+
+/**
+ * @brief Set the hook called when events are taken or freed
+ *
+ * @param q Queue to configure
+ * @param hook Hook function, or NULL to disable
+ * @param ctx Context pointer passed to the hook
+ */
+void sc_queue_set_hook(sc_queue_t *q, sc_queue_hook_t hook, void *ctx);
+
+/**
+ * @brief Push an event into the queue
+ *
+ * Handles overflow according to SAFECORE_QUEUE_OVERFLOW_POLICY. DROP_OLDEST
+ * evicts the oldest event only while the consumer holds no slot. Held slots
+ * sit at the tail, so while any is held (by sc_queue_peek(),
+ * sc_queue_peek_batch() or the pop of the event being delivered) the new
+ * event is dropped instead, even if events behind the held ones are queued.
+ * In MPSC mode producers never move the consumer position, so
+ * DROP_OLDEST behaves like DROP_NEWEST. Safe to call from several producers
+ * concurrently in MPSC mode.
+ *
+ * @param q Queue to push to
+ * @param data Pointer to the event data to copy
+ * @param size Size of the event data in bytes
+ * @return int 0 on success, -1 on failure (invalid parameters or event dropped)
+ */
+int sc_queue_push(sc_queue_t *q, const uint8_t *data, size_t size);
+
+/**
+ * @brief Reserve a slot for building an event in place
+ *
+ * Claims the next slot and returns a pointer to it. The event becomes
+ * visible to the consumer only after sc_queue_commit(). Overflow is handled
+ * as in sc_queue_push(). Without MPSC mode only one reservation per queue
+ * may be outstanding and it must not be interleaved with other pushes.
+ *
+ * @param q Queue to reserve in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure
+ */
+uint8_t* sc_queue_reserve(sc_queue_t *q, size_t size);
+
+#if SAFECORE_MPSC_ENABLED != 1
+/**
+ * @brief Claim the next slot as part of a batch
+ *
+ * Staged events follow each other after the head and become visible to the
+ * consumer together, with a single head update, on sc_queue_publish(). The
+ * caller writes each event before publishing. Staging may not be mixed with
+ * an outstanding reservation. Not available in MPSC mode, where every slot
+ * is published individually.
+ *
+ * @param q Queue to stage in
+ * @param size Size of the event in bytes
+ * @return uint8_t* Pointer to the slot, or NULL on failure (invalid parameters or event dropped)
+ */
+uint8_t* sc_queue_stage(sc_queue_t *q, size_t size);
+
+/**
+ * @brief Publish all staged events
+ *
+ * @param q Queue to publish
+ */
+void sc_queue_publish(sc_queue_t *q);
+#endif
+
+/**
+ * @brief Commit a reserved slot
+ *
+ * @param q Queue the slot was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_commit(sc_queue_t *q, uint8_t *slot);
+
+/**
+ * @brief Give up a reserved slot
+ *
+ * The slot is committed as empty and skipped by the consumer.
+ *
+ * @param q Queue the slot was reserved in
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return int 0 on success, -1 on invalid parameters
+ */
+int sc_queue_discard(sc_queue_t *q, uint8_t *slot);
+
+/**
+ * @brief Look at the oldest event without removing it
+ *
+ * Returns a pointer into the queue slot. The slot stays owned by the
+ * consumer until sc_queue_release(), so producers cannot overwrite it while
+ * it is being delivered. Calling peek again before release returns the same
+ * event. Single consumer only.
+ *
+ * @param q Queue to peek at
+ * @param out_size Pointer to store the size of the event
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_queue_peek(sc_queue_t *q, size_t *out_size);
+
+/**
+ * @brief Look at several of the oldest events without removing them
+ *
+ * Fills events/sizes with up to max consecutive events from the tail. All
+ * of them stay owned by the consumer until sc_queue_release(). Must not be
+ * called while events are held. Single consumer only.
+ *
+ * @param q Queue to peek at
+ * @param events Array to receive up to max event pointers
+ * @param sizes Array to receive the event sizes
+ * @param max Maximum number of events to return
+ * @return uint16_t Number of events returned
+ */
+uint16_t sc_queue_peek_batch(sc_queue_t *q, const uint8_t *events[], size_t sizes[], uint16_t max);
+
+/**
+ * @brief Release the slots held by the consumer
+ *
+ * Removes the events returned by the last peek, pop or batch peek and hands
+ * their slots back to producers. No-op if no slot is held.
+ *
+ * @param q Queue to release the slots of
+ */
+void sc_queue_release(sc_queue_t *q);
+
+/**
+ * @brief Pop the oldest event from the queue
+ *
+ * Releases the slot held from the previous pop, then peeks at the next
+ * event. Call sc_queue_release() after the last delivered event.
+ *
+ * @param q Queue to pop from
+ * @param out_size Pointer to store the size of the popped event
+ * @return const uint8_t* Pointer to the event data, or NULL if the queue is empty
+ */
+const uint8_t* sc_queue_pop(sc_queue_t *q, size_t *out_size);
+
+/**
+ * @brief Check whether a pointer lies in the queue's event storage
+ *
+ * @param q Queue to check
+ * @param p Pointer to check
+ * @return int 1 if p points into the queue storage, 0 otherwise
+ */
+int sc_queue_owns(const sc_queue_t *q, const uint8_t *p);
+
+/**
+ * @brief Get the size a slot was reserved with
+ *
+ * @param q Queue that owns the slot
+ * @param slot Pointer returned by sc_queue_reserve()
+ * @return size_t Reserved size in bytes, 0 if the slot is not in the queue
+ */
+size_t sc_queue_reserved_size(const sc_queue_t *q, const uint8_t *slot);
+
+/**
+ * @brief Get the number of events in the queue
+ *
+ * @param q Queue to query
+ * @return uint16_t Number of queued events
+ */
+uint16_t sc_queue_depth(const sc_queue_t *q);
+
+/**
+ * @brief Get the number of events dropped on overflow
+ *
+ * @param q Queue to query
+ * @return uint32_t Number of dropped events
+ */
+uint32_t sc_queue_dropped(const sc_queue_t *q);
+
+/**
+ * @brief Get the number of maximum-size events the queue holds
+ *
+ * In variable-length mode smaller events fit more often.
+ *
+ * @param q Queue to query
+ * @return uint16_t Capacity in events
+ */
+uint16_t sc_queue_capacity(const sc_queue_t *q);
+
+/**
+ * @brief Check whether an event fits without overflow handling
+ *
+ * A snapshot: in MPSC mode other producers may take the room before the
+ * caller pushes.
+ *
+ * @param q Queue to check
+ * @param size Size of the event in bytes
+ * @return int 1 if a push of size bytes would not overflow, 0 otherwise
+ */
+int sc_queue_can_push(const sc_queue_t *q, size_t size);
+
+#endif /* SAFECORE_BASIC_ENABLED */
+#endif /* SAFECORE_QUEUE_H */
@@ -0,0 +1,221 @@
+/*
+ * safecore_spill.c
+ *
+ * SafeCore Spill File Implementation
+ * This file implements the memory-mapped overflow ring of the low priority
+ * levels on POSIX file and mmap calls.
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "safecore_spill.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if SAFECORE_SPILL_ENABLED == 1
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * @brief File bytes taken by a record with the given payload length
+ */
+#define SPILL_RECORD_BYTES(len) \
+    ((((uint32_t)(len) + (uint32_t)sizeof(sc_spill_record_t)) + (SC_SPILL_RECORD_ALIGN - 1U)) & \
+     ~(SC_SPILL_RECORD_ALIGN - 1U))
+
+/**
+ * @brief Get the record at a free-running byte count
+ *
+ * @param s Spill ring
+ * @param pos Byte count (head or tail)
+ * @return sc_spill_record_t* Record header in the mapped file
+ */
+SAFECORE_INLINE sc_spill_record_t* spill_record_at(const sc_spill_t *s, uint32_t pos) {
+    return (sc_spill_record_t *)(void *)&s->buf[pos & (s->bytes - 1U)];
+}
+
+/**
+ * @brief Create a spill file and map it
+ *
+ * The blocks are allocated up front, so writing to the mapping cannot fail
+ * later for lack of disk space.
+ *
+ * @param s Spill ring to open
+ * @param path Path of the backing file
+ * @param bytes File size in bytes
+ * @return int 0 on success, -1 on failure
+ */
+int sc_spill_open(sc_spill_t *s, const char *path, uint32_t bytes) {
+    if ((s == NULL) || (path == NULL) || (bytes < SC_SPILL_MIN_BYTES) ||
+        ((bytes & (bytes - 1U)) != 0U) || (s->buf != NULL)) {
+        return -1;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (posix_fallocate(fd, 0, (off_t)bytes) != 0) {
+        (void)close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        (void)close(fd);
+        return -1;
+    }
+
+    (void)memset(s, 0, sizeof(*s));
+    s->buf = (uint8_t *)map;
+    s->bytes = bytes;
+    s->fd = fd;
+    return 0;
+}
+
+/**
+ * @brief Unmap and close a spill file
+ *
+ * @param s Spill ring to close
+ */
+void sc_spill_close(sc_spill_t *s) {
+    if ((s == NULL) || (s->buf == NULL)) {
+        return;
+    }
+
+    (void)munmap(s->buf, s->bytes);
+    (void)close(s->fd);
+    (void)memset(s, 0, sizeof(*s));
+}
+
+/**
+ * @brief Check whether a spill file is open
+ *
+ * @param s Spill ring
+ * @return int 1 if open, 0 otherwise
+ */
+int sc_spill_is_open(const sc_spill_t *s) {
+    return ((s != NULL) && (s->buf != NULL)) ? 1 : 0;
+}
+
+/**
+ * @brief Reserve room for a record at the head
+ *
+ * A record that would cross the end of the file starts at the beginning
+ * instead; the rest of the file is marked as filler.
+ *
+ * @param s Spill ring
+ * @param size Payload size in bytes
+ * @return uint8_t* Pointer to the payload, or NULL if the file is closed or full
+ */
+uint8_t* sc_spill_reserve(sc_spill_t *s, size_t size) {
+    if ((s == NULL) || (s->buf == NULL) || (size == 0U) || (size > 0xFFFFU) ||
+        (s->reserved != 0U)) {
+        return NULL;
+    }
+
+    uint32_t need = SPILL_RECORD_BYTES(size);
+    uint32_t off = s->head & (s->bytes - 1U);
+    uint32_t pad = ((off + need) > s->bytes) ? (s->bytes - off) : 0U;
+    if ((s->bytes - (s->head - s->tail)) < (pad + need)) {
+        s->dropped++;
+        return NULL;
+    }
+
+    if (pad != 0U) {
+        sc_spill_record_t *filler = spill_record_at(s, s->head);
+        filler->len = 0U;
+        filler->flags = SC_SPILL_REC_PAD;
+        s->head += pad;
+    }
+
+    s->reserved = (uint16_t)size;
+    return (uint8_t *)(void *)(spill_record_at(s, s->head) + 1);
+}
+
+/**
+ * @brief Publish the reserved record
+ *
+ * @param s Spill ring
+ */
+void sc_spill_commit(sc_spill_t *s) {
+    if ((s == NULL) || (s->buf == NULL) || (s->reserved == 0U)) {
+        return;
+    }
+
+    sc_spill_record_t *rec = spill_record_at(s, s->head);
+    rec->len = s->reserved;
+    rec->flags = 0U;
+
+    /* The header is complete before the consumer can see the record */
+    s->head += SPILL_RECORD_BYTES(s->reserved);
+    s->pushed++;
+    s->reserved = 0U;
+}
+
+/**
+ * @brief Look at the oldest record in place
+ *
+ * @param s Spill ring
+ * @param out_size Pointer to store the payload size (may be NULL)
+ * @return const uint8_t* Pointer to the payload, or NULL if the file is empty
+ */
+const uint8_t* sc_spill_peek(sc_spill_t *s, size_t *out_size) {
+    if ((s == NULL) || (s->buf == NULL)) {
+        return NULL;
+    }
+
+    while (s->tail != s->head) {
+        const sc_spill_record_t *rec = spill_record_at(s, s->tail);
+        if ((rec->flags & SC_SPILL_REC_PAD) != 0U) {
+            /* Filler: continue at the beginning of the file */
+            s->tail += s->bytes - (s->tail & (s->bytes - 1U));
+            continue;
+        }
+        if (out_size != NULL) {
+            *out_size = rec->len;
+        }
+        return (const uint8_t *)(const void *)(rec + 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remove the record returned by sc_spill_peek()
+ *
+ * @param s Spill ring
+ */
+void sc_spill_release(sc_spill_t *s) {
+    size_t size;
+
+    if (sc_spill_peek(s, &size) != NULL) {
+        s->tail += SPILL_RECORD_BYTES(size);
+        s->popped++;
+    }
+}
+
+/**
+ * @brief Get the number of records in the file
+ *
+ * @param s Spill ring
+ * @return uint32_t Number of committed records not yet released
+ */
+uint32_t sc_spill_pending(const sc_spill_t *s) {
+    return ((s != NULL) && (s->buf != NULL)) ? (s->pushed - s->popped) : 0U;
+}
+
+/**
+ * @brief Get the number of records that did not fit into the file
+ *
+ * @param s Spill ring
+ * @return uint32_t Number of dropped records
+ */
+uint32_t sc_spill_dropped(const sc_spill_t *s) {
+    return (s != NULL) ? s->dropped : 0U;
+}
+
+#endif /* SAFECORE_SPILL_ENABLED */
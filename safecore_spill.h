@@ -0,0 +1,136 @@
+/*
+ * safecore_spill.h
+ *
+ * SafeCore Spill File Interface
+ * This file defines the overflow tier of the low priority levels: a byte
+ * ring of [header][event] records in a memory-mapped file. Events that do
+ * not fit into their RAM queue are appended to the file and paged back into
+ * the queue as the consumer drains it, so bulk traffic such as logs and
+ * telemetry is buffered by the page cache instead of static RAM.
+ *
+ * The ring has one producer and one consumer. The producer only moves the
+ * head and the consumer only moves the tail, like the fixed-slot queue.
+ */
+#ifndef SAFECORE_SPILL_H
+#define SAFECORE_SPILL_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include <stddef.h>
+
+#if SAFECORE_SPILL_ENABLED == 1
+
+/**
+ * @brief Record header in the spill file
+ */
+typedef struct {
+    uint16_t len;                   /* Payload length in bytes */
+    uint16_t flags;                 /* SC_SPILL_REC_* flags */
+} sc_spill_record_t;
+
+#define SC_SPILL_RECORD_ALIGN       4U
+#define SC_SPILL_REC_PAD            0x0001U /* Filler up to the end of the file */
+#define SC_SPILL_MIN_BYTES          4096U   /* Smallest spill file */
+
+/**
+ * @brief Spill file ring
+ *
+ * Head and tail are free-running byte counts, so the file size must be a
+ * power of two; head - tail is the number of bytes in use.
+ */
+typedef struct {
+    uint8_t *buf;                   /* Mapped file, NULL while closed */
+    uint32_t bytes;                 /* File size in bytes (power of 2) */
+    int fd;                         /* File descriptor */
+    volatile uint32_t head;         /* Bytes written (producer) */
+    volatile uint32_t tail;         /* Bytes consumed (consumer) */
+    volatile uint32_t pushed;       /* Records committed (producer) */
+    volatile uint32_t popped;       /* Records released (consumer) */
+    uint32_t dropped;               /* Records that did not fit (producer) */
+    uint16_t reserved;              /* Payload length of the open reservation, 0 if none */
+} sc_spill_t;
+
+/**
+ * @brief Create a spill file and map it
+ *
+ * The file is created or truncated: events left by an earlier run are not
+ * replayed.
+ *
+ * @param s Spill ring to open
+ * @param path Path of the backing file
+ * @param bytes File size in bytes, a power of two of at least SC_SPILL_MIN_BYTES
+ * @return int 0 on success, -1 on failure (invalid parameters, already open or I/O error)
+ */
+int sc_spill_open(sc_spill_t *s, const char *path, uint32_t bytes);
+
+/**
+ * @brief Unmap and close a spill file
+ *
+ * Events still in the file are lost.
+ *
+ * @param s Spill ring to close
+ */
+void sc_spill_close(sc_spill_t *s);
+
+/**
+ * @brief Check whether a spill file is open
+ *
+ * @param s Spill ring
+ * @return int 1 if open, 0 otherwise
+ */
+int sc_spill_is_open(const sc_spill_t *s);
+
+/**
+ * @brief Reserve room for a record at the head
+ *
+ * The record becomes visible to the consumer with sc_spill_commit().
+ *
+ * @param s Spill ring
+ * @param size Payload size in bytes
+ * @return uint8_t* Pointer to the payload, or NULL if the file is closed or full
+ */
+uint8_t* sc_spill_reserve(sc_spill_t *s, size_t size);
+
+/**
+ * @brief Publish the reserved record
+ *
+ * @param s Spill ring
+ */
+void sc_spill_commit(sc_spill_t *s);
+
+/**
+ * @brief Look at the oldest record in place
+ *
+ * Consumer side. Skips the filler at the end of the file.
+ *
+ * @param s Spill ring
+ * @param out_size Pointer to store the payload size (may be NULL)
+ * @return const uint8_t* Pointer to the payload, or NULL if the file is empty
+ */
+const uint8_t* sc_spill_peek(sc_spill_t *s, size_t *out_size);
+
+/**
+ * @brief Remove the record returned by sc_spill_peek()
+ *
+ * @param s Spill ring
+ */
+void sc_spill_release(sc_spill_t *s);
+
+/**
+ * @brief Get the number of records in the file
+ *
+ * @param s Spill ring
+ * @return uint32_t Number of committed records not yet released
+ */
+uint32_t sc_spill_pending(const sc_spill_t *s);
+
+/**
+ * @brief Get the number of records that did not fit into the file
+ *
+ * @param s Spill ring
+ * @return uint32_t Number of dropped records
+ */
+uint32_t sc_spill_dropped(const sc_spill_t *s);
+
+#endif /* SAFECORE_SPILL_ENABLED */
+#endif /* SAFECORE_SPILL_H */
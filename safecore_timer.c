@@ -0,0 +1,464 @@
+/*
+ * safecore_timer.c
+ *
+ * SafeCore Timer Implementation
+ * This file implements the timer service as a hierarchical timing wheel of
+ * four levels with 64 slots each and a 1 ms tick. A timer sits in the level
+ * that covers its remaining delay; when the lower level wraps around, the
+ * slot of the next level is cascaded down. Slots are intrusive doubly
+ * linked lists of timer indices, so no operation depends on the number of
+ * armed timers.
+ */
+#include "safecore_timer.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <string.h>
+
+#if SAFECORE_TIMER_ENABLED == 1
+
+#define TIMER_LEVELS              4U
+#define TIMER_SLOT_BITS           6U
+#define TIMER_SLOTS               (1U << TIMER_SLOT_BITS)
+#define TIMER_SLOT_MASK           (TIMER_SLOTS - 1U)
+
+/* List of timers being expired by the current tick */
+#define TIMER_LIST_EXPIRING       (TIMER_LEVELS * TIMER_SLOTS)
+#define TIMER_LIST_COUNT          (TIMER_LIST_EXPIRING + 1U)
+
+#define TIMER_NONE                0xFFFFU
+
+/* Wheel slot of an expiry time on a level */
+#define TIMER_SLOT(expires, level) \
+    (((level) * TIMER_SLOTS) + (((expires) >> ((level) * TIMER_SLOT_BITS)) & TIMER_SLOT_MASK))
+
+/* The four levels must cover the longest delay */
+SC_STATIC_ASSERT(SC_TIMER_MAX_DELAY_MS < (1UL << (TIMER_LEVELS * TIMER_SLOT_BITS)),
+                 safecore_timer_max_delay_exceeds_wheel);
+
+/**
+ * @brief One timer
+ */
+typedef struct {
+    uint64_t data[(SAFECORE_MAX_EVENT_SIZE + 7U) / 8U]; /* Event to publish */
+    sc_bus_t *bus;              /* Target instance */
+    uint32_t expires;           /* Expiry tick */
+    uint32_t period;            /* Period in ticks, 0 for one-shot timers */
+    uint16_t next;              /* Next timer in the list */
+    uint16_t prev;              /* Previous timer in the list */
+    uint16_t list;              /* List the timer is on, TIMER_NONE when free */
+    uint16_t gen;               /* Generation, bumped when the timer is freed */
+    uint16_t size;              /* Event size in bytes */
+    uint8_t id;                 /* Event ID, for sc_timer_cancel_event() */
+} timer_entry_t;
+
+/**
+ * @brief Timer service state
+ */
+typedef struct {
+    timer_entry_t timers[SAFECORE_MAX_TIMERS];
+    uint16_t heads[TIMER_LIST_COUNT];   /* First timer of each list */
+    uint16_t free_head;                 /* First free timer */
+    uint16_t armed;                     /* Number of armed timers */
+    uint32_t now;                       /* Next tick to process */
+} timer_wheel_t;
+
+/* === Global Variables === */
+static timer_wheel_t g_wheel;
+
+/**
+ * @brief Append a timer to a list
+ *
+ * @param idx Timer index
+ * @param list List index
+ */
+static void timer_link(uint16_t idx, uint16_t list) {
+    timer_entry_t *t = &g_wheel.timers[idx];
+
+    t->list = list;
+    t->prev = TIMER_NONE;
+    t->next = g_wheel.heads[list];
+    if (t->next != TIMER_NONE) {
+        g_wheel.timers[t->next].prev = idx;
+    }
+    g_wheel.heads[list] = idx;
+}
+
+/**
+ * @brief Remove a timer from its list
+ *
+ * @param idx Timer index
+ */
+static void timer_unlink(uint16_t idx) {
+    timer_entry_t *t = &g_wheel.timers[idx];
+
+    if (t->prev != TIMER_NONE) {
+        g_wheel.timers[t->prev].next = t->next;
+    } else {
+        g_wheel.heads[t->list] = t->next;
+    }
+    if (t->next != TIMER_NONE) {
+        g_wheel.timers[t->next].prev = t->prev;
+    }
+}
+
+/**
+ * @brief Put a timer into the wheel slot covering its expiry
+ *
+ * @param idx Timer index
+ */
+static void timer_insert(uint16_t idx) {
+    uint32_t expires = g_wheel.timers[idx].expires;
+    int32_t delta = (int32_t)(expires - g_wheel.now);
+    uint16_t list;
+
+    if (delta < 0) {
+        /* Tick already processed: expire with the next sc_timer_process() */
+        list = (uint16_t)TIMER_LIST_EXPIRING;
+    } else if ((uint32_t)delta < (1UL << TIMER_SLOT_BITS)) {
+        list = (uint16_t)TIMER_SLOT(expires, 0U);
+    } else if ((uint32_t)delta < (1UL << (2U * TIMER_SLOT_BITS))) {
+        list = (uint16_t)TIMER_SLOT(expires, 1U);
+    } else if ((uint32_t)delta < (1UL << (3U * TIMER_SLOT_BITS))) {
+        list = (uint16_t)TIMER_SLOT(expires, 2U);
+    } else {
+        list = (uint16_t)TIMER_SLOT(expires, 3U);
+    }
+
+    timer_link(idx, list);
+}
+
+/**
+ * @brief Return a timer to the free list
+ *
+ * @param idx Timer index
+ */
+static void timer_free(uint16_t idx) {
+    timer_entry_t *t = &g_wheel.timers[idx];
+
+    t->list = TIMER_NONE;
+    t->gen++;
+    t->next = g_wheel.free_head;
+    g_wheel.free_head = idx;
+    g_wheel.armed--;
+}
+
+/**
+ * @brief Get the index of a live timer handle
+ *
+ * @param timer Timer handle
+ * @param out_idx Pointer to store the timer index
+ * @return int 0 if the handle refers to an armed timer, -1 otherwise
+ */
+static int timer_lookup(sc_timer_t timer, uint16_t *out_idx) {
+    uint16_t idx = (uint16_t)(timer & 0xFFFFU);
+
+    if ((idx >= SAFECORE_MAX_TIMERS) || (g_wheel.timers[idx].list == TIMER_NONE) ||
+        (g_wheel.timers[idx].gen != (uint16_t)(timer >> 16))) {
+        return -1;
+    }
+
+    *out_idx = idx;
+    return 0;
+}
+
+/**
+ * @brief Arm a timer
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_data Event to publish
+ * @param size Size of the event in bytes
+ * @param delay_ms Delay until the first expiry
+ * @param period_ms Period, 0 for one-shot timers
+ * @return sc_timer_t Timer handle, or SC_TIMER_INVALID on failure
+ */
+static sc_timer_t timer_arm(sc_bus_t *bus, const uint8_t *event_data, size_t size,
+                            uint32_t delay_ms, uint32_t period_ms) {
+    uint32_t now = safecore_get_tick_ms();
+    uint16_t idx;
+    timer_entry_t *t;
+
+    if ((event_data == NULL) || (size < sizeof(sc_event_t)) || (size > SAFECORE_MAX_EVENT_SIZE) ||
+        (delay_ms > SC_TIMER_MAX_DELAY_MS)) {
+        return SC_TIMER_INVALID;
+    }
+
+    if (g_wheel.armed == 0U) {
+        /* Idle wheel: catch up without walking the skipped ticks */
+        g_wheel.now = now;
+    } else if ((int32_t)((now + delay_ms) - g_wheel.now) > (int32_t)SC_TIMER_MAX_DELAY_MS) {
+        /* Wheel lags too far behind for the slot to be unambiguous */
+        return SC_TIMER_INVALID;
+    } else {
+        /* Armed relative to the current tick */
+    }
+
+    idx = g_wheel.free_head;
+    if (idx == TIMER_NONE) {
+        return SC_TIMER_INVALID;
+    }
+    t = &g_wheel.timers[idx];
+    g_wheel.free_head = t->next;
+    g_wheel.armed++;
+
+    (void)memcpy(t->data, event_data, size);
+    t->bus = (bus != NULL) ? bus : sc_eventbus_default();
+    t->size = (uint16_t)size;
+    t->id = event_data[offsetof(sc_event_t, id)];
+    t->expires = now + delay_ms;
+    t->period = period_ms;
+    timer_insert(idx);
+
+    return ((sc_timer_t)t->gen << 16) | idx;
+}
+
+/**
+ * @brief Re-sort one wheel slot into the lower levels
+ *
+ * @param level Level of the slot
+ * @param tick Tick that selects the slot
+ * @return uint32_t Index of the cascaded slot within its level
+ */
+static uint32_t timer_cascade(uint32_t level, uint32_t tick) {
+    uint16_t list = (uint16_t)TIMER_SLOT(tick, level);
+    uint16_t idx = g_wheel.heads[list];
+
+    g_wheel.heads[list] = TIMER_NONE;
+    while (idx != TIMER_NONE) {
+        uint16_t next = g_wheel.timers[idx].next;
+        timer_insert(idx);
+        idx = next;
+    }
+
+    return list & TIMER_SLOT_MASK;
+}
+
+/**
+ * @brief Publish the timers on the expiring list
+ *
+ * @param now_ms Current tick in milliseconds, which periodic timers are re-armed after
+ */
+static void timer_expire(uint32_t now_ms) {
+    uint16_t idx;
+
+    while ((idx = g_wheel.heads[TIMER_LIST_EXPIRING]) != TIMER_NONE) {
+        timer_entry_t *t = &g_wheel.timers[idx];
+
+        timer_unlink(idx);
+        (void)sc_bus_publish_raw(t->bus, (const uint8_t *)t->data, t->size);
+
+        if (t->period != 0U) {
+            /* Next period boundary after now; missed periods are skipped */
+            uint32_t late = now_ms - t->expires;
+            t->expires += ((late / t->period) + 1U) * t->period;
+            timer_insert(idx);
+        } else {
+            timer_free(idx);
+        }
+    }
+}
+
+/**
+ * @brief Process one tick of the wheel
+ *
+ * @param now_ms Current tick in milliseconds
+ */
+static void timer_tick(uint32_t now_ms) {
+    uint32_t tick = g_wheel.now;
+    uint16_t slot = (uint16_t)TIMER_SLOT(tick, 0U);
+    uint16_t idx;
+
+    /* Cascade the higher levels whenever the level below wraps around */
+    if (((tick & TIMER_SLOT_MASK) == 0U) && (timer_cascade(1U, tick) == 0U) &&
+        (timer_cascade(2U, tick) == 0U)) {
+        (void)timer_cascade(3U, tick);
+    }
+
+    /* Move the due slot aside so expiring timers may be re-armed into the wheel */
+    idx = g_wheel.heads[slot];
+    g_wheel.heads[slot] = TIMER_NONE;
+    while (idx != TIMER_NONE) {
+        uint16_t next = g_wheel.timers[idx].next;
+        timer_link(idx, TIMER_LIST_EXPIRING);
+        idx = next;
+    }
+    g_wheel.now = tick + 1U;
+
+    timer_expire(now_ms);
+}
+
+/**
+ * @brief Reset the timer service
+ */
+void sc_timer_init(void) {
+    uint16_t i;
+
+    (void)memset(&g_wheel, 0, sizeof(g_wheel));
+    for (i = 0U; i < TIMER_LIST_COUNT; i++) {
+        g_wheel.heads[i] = TIMER_NONE;
+    }
+    for (i = 0U; i < SAFECORE_MAX_TIMERS; i++) {
+        g_wheel.timers[i].list = TIMER_NONE;
+        g_wheel.timers[i].next = (uint16_t)(i + 1U);
+    }
+    g_wheel.timers[SAFECORE_MAX_TIMERS - 1U].next = TIMER_NONE;
+    g_wheel.free_head = 0U;
+    g_wheel.now = safecore_get_tick_ms();
+}
+
+/**
+ * @brief Publish an event once after a delay
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_data Event to publish
+ * @param size Size of the event in bytes
+ * @param delay_ms Delay in milliseconds
+ * @return sc_timer_t Timer handle, or SC_TIMER_INVALID on failure
+ */
+sc_timer_t sc_timer_publish_after(sc_bus_t *bus, const uint8_t *event_data, size_t size, uint32_t delay_ms) {
+    return timer_arm(bus, event_data, size, delay_ms, 0U);
+}
+
+/**
+ * @brief Publish an event periodically
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_data Event to publish
+ * @param size Size of the event in bytes
+ * @param period_ms Period in milliseconds
+ * @return sc_timer_t Timer handle, or SC_TIMER_INVALID on failure
+ */
+sc_timer_t sc_timer_publish_every(sc_bus_t *bus, const uint8_t *event_data, size_t size, uint32_t period_ms) {
+    if (period_ms == 0U) {
+        return SC_TIMER_INVALID;
+    }
+
+    return timer_arm(bus, event_data, size, period_ms, period_ms);
+}
+
+/**
+ * @brief Cancel a timer
+ *
+ * @param timer Timer handle
+ * @return int 0 on success, -1 if the timer is not armed
+ */
+int sc_timer_cancel(sc_timer_t timer) {
+    uint16_t idx;
+
+    if (timer_lookup(timer, &idx) != 0) {
+        return -1;
+    }
+
+    timer_unlink(idx);
+    timer_free(idx);
+    return 0;
+}
+
+/**
+ * @brief Cancel all timers publishing an event ID on a bus
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_id Event ID
+ * @return int Number of cancelled timers
+ */
+int sc_timer_cancel_event(sc_bus_t *bus, uint8_t event_id) {
+    sc_bus_t *target = (bus != NULL) ? bus : sc_eventbus_default();
+    int cancelled = 0;
+    uint16_t i;
+
+    for (i = 0U; i < SAFECORE_MAX_TIMERS; i++) {
+        timer_entry_t *t = &g_wheel.timers[i];
+        if ((t->list != TIMER_NONE) && (t->bus == target) && (t->id == event_id)) {
+            timer_unlink(i);
+            timer_free(i);
+            cancelled++;
+        }
+    }
+
+    return cancelled;
+}
+
+/**
+ * @brief Advance the wheel and publish expired timers
+ *
+ * @param now_ms Current tick in milliseconds
+ */
+void sc_timer_process(uint32_t now_ms) {
+    if (g_wheel.armed == 0U) {
+        /* Idle wheel, also when processing a bus before sc_timer_init() */
+        return;
+    }
+
+    /* Timers armed for a tick that was already processed */
+    timer_expire(now_ms);
+
+    while ((int32_t)(now_ms - g_wheel.now) >= 0) {
+        if (g_wheel.armed == 0U) {
+            g_wheel.now = now_ms + 1U;
+            break;
+        }
+        timer_tick(now_ms);
+    }
+}
+
+/**
+ * @brief Get the time until the wheel next needs processing
+ *
+ * @param now_ms Current tick in milliseconds
+ * @param delay_ms Pointer to store the delay in milliseconds
+ * @return int 0 if a timer is armed, -1 if no timer is armed
+ */
+int sc_timer_next_expiry(uint32_t now_ms, uint32_t *delay_ms) {
+    uint32_t next = 0U;
+    uint32_t level;
+    int found = 0;
+
+    if ((delay_ms == NULL) || (g_wheel.armed == 0U)) {
+        return -1;
+    }
+
+    if (g_wheel.heads[TIMER_LIST_EXPIRING] != TIMER_NONE) {
+        *delay_ms = 0U;
+        return 0;
+    }
+
+    for (level = 0U; level < TIMER_LEVELS; level++) {
+        uint32_t shift = level * TIMER_SLOT_BITS;
+        uint32_t k;
+
+        /* k == TIMER_SLOTS revisits the current slot one round later */
+        for (k = 0U; k <= TIMER_SLOTS; k++) {
+            /* Tick at which the slot k positions ahead is expired or cascaded */
+            uint32_t tick = ((g_wheel.now >> shift) + k) << shift;
+            if ((int32_t)(tick - g_wheel.now) < 0) {
+                continue;
+            }
+            if (found && ((int32_t)(tick - next) >= 0)) {
+                break;
+            }
+            if (g_wheel.heads[TIMER_SLOT(tick, level)] != TIMER_NONE) {
+                next = tick;
+                found = 1;
+                break;
+            }
+        }
+    }
+
+    if (!found) {
+        /* Every armed timer is in a slot; process right away if not */
+        next = now_ms;
+    }
+
+    *delay_ms = ((int32_t)(next - now_ms) > 0) ? (next - now_ms) : 0U;
+    return 0;
+}
+
+/**
+ * @brief Get the number of armed timers
+ *
+ * @return uint16_t Number of armed timers
+ */
+uint16_t sc_timer_armed(void) {
+    return g_wheel.armed;
+}
+
+#endif /* SAFECORE_TIMER_ENABLED */
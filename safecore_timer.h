@@ -0,0 +1,128 @@
+/*
+ * safecore_timer.h
+ *
+ * SafeCore Timer Module
+ * This header file defines the timer service. Timers publish a copy of an
+ * event after a delay or periodically; they are kept in a hierarchical
+ * timing wheel so arming, cancelling and expiring a timer is O(1).
+ */
+
+#ifndef SAFECORE_TIMER_H
+#define SAFECORE_TIMER_H
+
+#include "safecore_types.h"
+#include "safecore_config.h"
+#include "safecore_core.h"
+#include <stddef.h>
+
+#if SAFECORE_TIMER_ENABLED == 1
+
+/**
+ * @defgroup SafeCore_TIMER SafeCore Timer Module
+ * @brief Delayed and periodic event publication
+ * @{
+ */
+
+/**
+ * @brief Timer handle
+ *
+ * Generation in the high half, timer index in the low half, so a handle of
+ * an expired or cancelled timer never refers to a reused one.
+ */
+typedef uint32_t sc_timer_t;
+
+#define SC_TIMER_INVALID          ((sc_timer_t)0xFFFFFFFFU)
+
+/* Longest delay or period in milliseconds covered by the wheel */
+#define SC_TIMER_MAX_DELAY_MS     0x00FFFFFFU
+
+/**
+ * @brief Reset the timer service
+ *
+ * Drops all armed timers. Called by sc_eventbus_init().
+ */
+void sc_timer_init(void);
+
+/**
+ * @brief Publish an event once after a delay
+ *
+ * The event is copied and published with sc_bus_publish_raw() when the delay
+ * has elapsed, so filters apply at expiry. State machines arm timeouts by
+ * publishing an event their subscriber dispatches.
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_data Event to publish
+ * @param size Size of the event in bytes (at most SAFECORE_MAX_EVENT_SIZE)
+ * @param delay_ms Delay in milliseconds (at most SC_TIMER_MAX_DELAY_MS)
+ * @return sc_timer_t Timer handle, or SC_TIMER_INVALID on invalid parameters or if all timers are in use
+ */
+sc_timer_t sc_timer_publish_after(sc_bus_t *bus, const uint8_t *event_data, size_t size, uint32_t delay_ms);
+
+/**
+ * @brief Publish an event periodically
+ *
+ * The first event is published one period from now. Periods missed because
+ * sc_timer_process() ran late are skipped rather than replayed.
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_data Event to publish
+ * @param size Size of the event in bytes (at most SAFECORE_MAX_EVENT_SIZE)
+ * @param period_ms Period in milliseconds (1 to SC_TIMER_MAX_DELAY_MS)
+ * @return sc_timer_t Timer handle, or SC_TIMER_INVALID on invalid parameters or if all timers are in use
+ */
+sc_timer_t sc_timer_publish_every(sc_bus_t *bus, const uint8_t *event_data, size_t size, uint32_t period_ms);
+
+/**
+ * @brief Cancel a timer
+ *
+ * @param timer Timer handle
+ * @return int 0 on success, -1 if the timer has already expired or was cancelled
+ */
+int sc_timer_cancel(sc_timer_t timer);
+
+/**
+ * @brief Cancel all timers publishing an event ID on a bus
+ *
+ * @param bus Event bus instance, NULL for the default bus
+ * @param event_id Event ID
+ * @return int Number of cancelled timers
+ */
+int sc_timer_cancel_event(sc_bus_t *bus, uint8_t event_id);
+
+/**
+ * @brief Advance the wheel and publish expired timers
+ *
+ * Called by sc_bus_process(), sc_bus_process_budget() and
+ * sc_bus_process_batch() of every instance, so timers of any bus fire as
+ * long as one instance is processed. The wheel is shared and not locked:
+ * arm and cancel timers on the thread that processes the buses.
+ *
+ * @param now_ms Current tick in milliseconds
+ */
+void sc_timer_process(uint32_t now_ms);
+
+/**
+ * @brief Get the time until the wheel next needs processing
+ *
+ * Exact for timers due within 64 ms; for later timers it returns the next
+ * cascade of their wheel slot, which is never after their expiry. Used by
+ * sc_eventbus_wait() to bound its sleep.
+ *
+ * @param now_ms Current tick in milliseconds
+ * @param delay_ms Pointer to store the delay in milliseconds
+ * @return int 0 if a timer is armed, -1 if no timer is armed
+ */
+int sc_timer_next_expiry(uint32_t now_ms, uint32_t *delay_ms);
+
+/**
+ * @brief Get the number of armed timers
+ *
+ * @return uint16_t Number of armed timers
+ */
+uint16_t sc_timer_armed(void);
+
+/** @} *//* End of SafeCore_TIMER group */
+
+#endif /* SAFECORE_TIMER_ENABLED */
+
+#endif /* SAFECORE_TIMER_H */
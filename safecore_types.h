@@ -11,6 +11,9 @@
 #include "safecore_config.h"
 #include "safecore_module_config.h"
 #include <stdint.h>
+#if (SAFECORE_FILTERS_ENABLED == 1) && (SAFECORE_FILTER_SWAP_ENABLED == 1)
+#include <stdatomic.h>
+#endif
 
 /* === Basic Event Types === */
 /**
@@ -54,7 +57,7 @@ typedef struct {
 typedef struct {
     uint32_t timestamp;      /* Event timestamp */
 #if SAFECORE_PRIORITY_ENABLED == 1
-    uint32_t timestampMicro; /* Microsecond portion of timestamp */
+    uint32_t timestampMicro; /* Enqueue time in microseconds, set by the event bus with SAFECORE_HISTOGRAM_ENABLED */
 #endif
     uint8_t id;              /* Event ID */
     uint8_t size;            /* Actual data size */
@@ -63,9 +66,16 @@ typedef struct {
 #else
     uint8_t reserved1;       /* Reserved field */
 #endif
-    uint8_t reserved2;       /* Alignment padding */
+    uint8_t flags;           /* SC_EVENT_FLAG_* flags, set by the event bus */
+#if (SAFECORE_PRIORITY_ENABLED == 1) && (SAFECORE_SCHED_POLICY == SAFECORE_SCHED_EDF)
+    uint16_t deadline;       /* Milliseconds after timestamp, 0 for SAFECORE_EDF_DEFAULT_DEADLINE_MS */
+    uint16_t reserved2;      /* Reserved field */
+#endif
 } sc_event_t;
 
+/* === Event Flags === */
+#define SC_EVENT_FLAG_POOLED      0x01U /* Event carries an sc_pool handle (see safecore_pool.h) */
+
 /* === State Machine Related Types === */
 /**
  * @brief State machine result type enumeration
@@ -115,6 +125,36 @@ typedef enum {
 } sc_priority_type_t;
 #endif
 
+/**
+ * @brief Priority bitmap type
+ *
+ * One bit per priority level, bit n for level n.
+ */
+#if SAFECORE_EVENT_PRIORITIES > 32
+typedef uint64_t sc_prio_mask_t;
+#else
+typedef uint32_t sc_prio_mask_t;
+#endif
+
+/**
+ * @brief Get the highest-priority level of a priority bitmap
+ *
+ * @param mask Non-zero priority bitmap
+ * @return uint8_t Index of the lowest set bit
+ */
+SAFECORE_INLINE uint8_t sc_prio_mask_first(sc_prio_mask_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctzll((unsigned long long)mask);
+#else
+    uint8_t n = 0U;
+    while ((mask & 1U) == 0U) {
+        mask >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
 /* === Filter Types === */
 #if SAFECORE_FILTERS_ENABLED == 1
 /**
@@ -127,7 +167,10 @@ typedef enum {
     SC_FILTER_TYPE_DENY,        /* Deny events that match criteria */
     SC_FILTER_TYPE_SIZE_MIN,    /* Filter by minimum size */
     SC_FILTER_TYPE_SIZE_MAX,    /* Filter by maximum size */
-    SC_FILTER_TYPE_PRIORITY     /* Filter by priority level */
+    SC_FILTER_TYPE_PRIORITY,    /* Filter by priority level */
+    SC_FILTER_TYPE_PROGRAM,     /* Drop events of event_id that filter program param rejects */
+    SC_FILTER_TYPE_RATE,        /* Limit events of event_id to param per second */
+    SC_FILTER_TYPE_BURST        /* Let up to param events of event_id through at once (default: the rate) */
 } sc_filter_type_t;
 
 /**
@@ -141,6 +184,116 @@ typedef struct {
     uint8_t event_id;           /* Event ID to filter */
     uint8_t param;              /* Additional filter parameter */
 } sc_filter_rule_t;
+
+/**
+ * @brief Compiled filter decision of one event ID
+ * 
+ * An event passes if allow is set and its size and priority lie within the
+ * bounds, which is what walking the rules gives for this ID.
+ */
+typedef struct {
+    uint8_t allow;              /* Result of the ID's last allow/deny rule, 1 if it has none */
+    uint8_t min_size;           /* Smallest size passing the size rules after that rule */
+    uint8_t max_size;           /* Largest size passing the size rules after that rule */
+    uint8_t max_priority;       /* Largest priority value passing the priority rules after that rule */
+#if SAFECORE_FILTER_VM_ENABLED == 1
+    uint8_t programs;           /* Bit per filter program run after the bounds check */
+#endif
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+    uint8_t rate;               /* Events per second after those checks, 0 for no limit */
+    uint8_t burst;              /* Token bucket depth in events */
+#endif
+} sc_filter_decision_t;
+
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+#define SC_FILTER_BUCKET_PRIMED     0x01U   /* Bucket filled since its rate was set */
+#define SC_FILTER_BUCKET_LIMITING   0x02U   /* Last event of the ID was dropped by the rate limit */
+#define SC_FILTER_BUCKET_REPORT     0x04U   /* Summary event not yet published */
+
+/**
+ * @brief Token bucket of one event ID
+ * 
+ * Tokens are counted in thousandths of an event, so a refill of rate
+ * events per second adds rate tokens per elapsed millisecond.
+ */
+typedef struct {
+    uint32_t tokens;            /* Thousandths of an event available */
+    uint32_t last_ms;           /* Tick of the last refill */
+    uint32_t dropped;           /* Events dropped by the rate limit */
+    uint8_t flags;              /* SC_FILTER_BUCKET_* flags */
+} sc_filter_bucket_t;
+#endif
+
+#if SAFECORE_FILTER_VM_ENABLED == 1
+#define SC_FVM_MEM_WORDS            4U  /* Memory words kept by a filter program between events */
+
+/**
+ * @brief Filter program instruction
+ * 
+ * See safecore_fvm.h for the instruction set.
+ */
+typedef struct {
+    uint8_t op;                 /* SC_FVM_* opcode */
+    uint8_t jt;                 /* Conditional jumps: instructions skipped if true */
+    uint8_t jf;                 /* Conditional jumps: instructions skipped if false */
+    uint8_t reserved;           /* Must be zero */
+    uint32_t k;                 /* Operand */
+} sc_fvm_insn_t;
+
+/**
+ * @brief Filter program slot
+ */
+typedef struct {
+    sc_fvm_insn_t insns[SAFECORE_FILTER_PROGRAM_LEN]; /* Verified instructions */
+    uint32_t mem[SC_FVM_MEM_WORDS];                   /* Memory kept between events */
+    uint8_t len;                                      /* Number of instructions, 0 if empty */
+} sc_fvm_program_t;
+#endif
+
+/**
+ * @brief Compiled filter table
+ * 
+ * What the filter check reads: the decisions compiled from the rules and
+ * the programs they run.
+ */
+typedef struct {
+    sc_filter_decision_t decisions[SAFECORE_MAX_EVENT_TYPES]; /* Compiled rules per event ID */
+#if SAFECORE_FILTER_VM_ENABLED == 1
+    sc_fvm_program_t programs[SAFECORE_FILTER_PROGRAMS];     /* Filter program slots */
+#endif
+} sc_filter_table_t;
+
+/**
+ * @brief Filter rule set structure
+ * 
+ * This structure holds the rule table of one event bus instance. The rule
+ * storage is provided by the owner of the set; the decision table is
+ * compiled from the rules whenever they change.
+ * 
+ * With SAFECORE_FILTER_SWAP_ENABLED, the rules and program slots are only
+ * the source of the next table. It is compiled into the table not in use
+ * and published by swapping the active pointer; publishers count
+ * themselves in and out of the table they read.
+ */
+typedef struct {
+    sc_filter_rule_t *rules;    /* Rule storage */
+    uint8_t count;              /* Number of active rules */
+    uint8_t max_rules;          /* Capacity of the rule storage */
+#if SAFECORE_FILTER_SWAP_ENABLED == 1
+    sc_filter_table_t tables[2];                    /* Published table and the one built next */
+    sc_filter_table_t *_Atomic active;              /* Table the filter check reads */
+    _Atomic uint32_t readers[2];                    /* Filter checks reading each table */
+#if SAFECORE_FILTER_VM_ENABLED == 1
+    sc_fvm_program_t programs[SAFECORE_FILTER_PROGRAMS]; /* Program slots of the next table */
+#endif
+#else
+    sc_filter_table_t table;    /* Compiled rules */
+#endif
+#if SAFECORE_FILTER_RATE_ENABLED == 1
+    sc_filter_bucket_t buckets[SAFECORE_MAX_EVENT_TYPES];    /* Rate limit state per event ID */
+    uint8_t reports;            /* Non-zero if a bucket has SC_FILTER_BUCKET_REPORT set */
+#endif
+} sc_filter_set_t;
 #endif
 
 /* === Diagnostics Related Types === */
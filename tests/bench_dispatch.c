@@ -0,0 +1,165 @@
+/*
+ * bench_dispatch.c
+ *
+ * SafeCore Dispatch Benchmark
+ * Measures the cost of delivering an event as the number of subscribers on
+ * the bus grows. The measured event ID always has one subscriber; all others
+ * listen to other IDs. With the per-ID dispatch chains the cost per event
+ * stays flat instead of growing with the subscriber table.
+ *
+ * Build with fixed-slot queues (SAFECORE_QUEUE_VARLEN_ENABLED set to 0), as
+ * in the default configuration:
+ *   gcc -std=c11 -O2 -I. tests/bench_dispatch.c safecore_*.c -o bench_dispatch
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "safecore_core.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <stdio.h>
+#include <time.h>
+
+#if SAFECORE_QUEUE_VARLEN_ENABLED == 1
+    #error "The dispatch benchmark sizes its queues in slots and needs SAFECORE_QUEUE_VARLEN_ENABLED set to 0"
+#endif
+
+/* === Benchmark Configuration === */
+#define BENCH_MAX_SUBSCRIBERS   1024U
+#define BENCH_QUEUE_SIZE        16U
+#define BENCH_BURST             8U       /* Events per processing call (below SAFECORE_MAX_EVENTS_PER_CYCLE) */
+#define BENCH_ROUNDS            100000U
+#define BENCH_EVENT_ID          0U
+
+SC_STATIC_ASSERT(BENCH_BURST <= SAFECORE_MAX_EVENTS_PER_CYCLE,
+                 bench_burst_must_fit_one_cycle);
+SC_STATIC_ASSERT(SAFECORE_MAX_EVENT_TYPES > 1,
+                 bench_needs_a_second_event_id);
+
+/* === Global Variables === */
+static sc_bus_t g_bus;
+static uint64_t g_bus_mem[SC_BUS_STORAGE_SIZE(BENCH_MAX_SUBSCRIBERS, BENCH_QUEUE_SIZE,
+                                              SAFECORE_MAX_EVENT_SIZE, SAFECORE_TOTAL_QUEUES,
+                                              SAFECORE_MAX_FILTER_RULES) / 8U + 1U];
+static uint32_t g_delivered;
+
+/* === Platform Interface Implementation === */
+
+/**
+ * @brief Get current time in nanoseconds
+ *
+ * @return uint64_t Monotonic time in nanoseconds
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Get current system tick in milliseconds
+ *
+ * @return uint32_t Monotonic time in milliseconds
+ */
+uint32_t safecore_get_tick_ms(void) {
+    return (uint32_t)(bench_now_ns() / 1000000U);
+}
+
+/**
+ * @brief Get current system tick in microseconds
+ *
+ * @return uint32_t Monotonic time in microseconds
+ */
+uint32_t safecore_get_tick_us(void) {
+    return (uint32_t)(bench_now_ns() / 1000U);
+}
+
+/**
+ * @brief Error handler for SafeCore operations
+ *
+ * @param msg Error message to log
+ */
+void safecore_error_handler(const char *msg) {
+    (void)printf("ERROR: %s\n", msg);
+}
+
+/* === Benchmark Implementation === */
+
+/**
+ * @brief Count one delivered event
+ *
+ * @param e Delivered event
+ * @param ctx Unused
+ */
+static void bench_on_event(const sc_event_t *e, void *ctx) {
+    (void)e;
+    (void)ctx;
+    g_delivered++;
+}
+
+/**
+ * @brief Measure delivery with a number of subscribers on the bus
+ *
+ * @param subscribers Total number of subscribers
+ * @return int 0 on success, -1 on failure
+ */
+static int bench_run(uint16_t subscribers) {
+    sc_bus_config_t cfg = { .max_subscribers = subscribers, .queue_size = BENCH_QUEUE_SIZE,
+                            .max_event_size = SAFECORE_MAX_EVENT_SIZE,
+                            .priorities = SAFECORE_TOTAL_QUEUES,
+                            .max_filter_rules = SAFECORE_MAX_FILTER_RULES };
+    sc_event_t evt = {0};
+    uint32_t round;
+    uint32_t n;
+    uint16_t i;
+
+    if (sc_bus_init(&g_bus, &cfg, g_bus_mem, sizeof(g_bus_mem)) != 0) {
+        return -1;
+    }
+
+    /* One subscriber of the measured ID, the others spread over the other IDs */
+    if (sc_bus_subscribe(&g_bus, BENCH_EVENT_ID, bench_on_event, NULL) != 0) {
+        return -1;
+    }
+    for (i = 1U; i < subscribers; i++) {
+        uint8_t id = (uint8_t)(1U + (i % (SAFECORE_MAX_EVENT_TYPES - 1U)));
+        if (sc_bus_subscribe(&g_bus, id, bench_on_event, NULL) != 0) {
+            return -1;
+        }
+    }
+
+    evt.id = BENCH_EVENT_ID;
+    evt.size = (uint8_t)sizeof(evt);
+    g_delivered = 0U;
+
+    uint64_t start = bench_now_ns();
+    for (round = 0U; round < BENCH_ROUNDS; round++) {
+        for (n = 0U; n < BENCH_BURST; n++) {
+            (void)sc_bus_publish_raw(&g_bus, (const uint8_t *)&evt, sizeof(evt));
+        }
+        sc_bus_process(&g_bus);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    if (g_delivered != (BENCH_ROUNDS * BENCH_BURST)) {
+        return -1;
+    }
+
+    (void)printf("%11u %12u %14.1f\n", (unsigned)subscribers, (unsigned)g_delivered,
+                 (double)elapsed / (double)g_delivered);
+    return 0;
+}
+
+int main(void) {
+    uint16_t subscribers;
+
+    (void)printf("%11s %12s %14s\n", "subscribers", "events", "ns/event");
+    for (subscribers = 1U; subscribers <= BENCH_MAX_SUBSCRIBERS; subscribers *= 4U) {
+        if (bench_run(subscribers) != 0) {
+            (void)printf("FAIL: run with %u subscribers\n", (unsigned)subscribers);
+            return 1;
+        }
+    }
+
+    return 0;
+}
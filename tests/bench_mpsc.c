@@ -0,0 +1,198 @@
+/*
+ * bench_mpsc.c
+ *
+ * SafeCore MPSC Throughput Benchmark
+ * Measures publish-to-delivery throughput of one bus instance with 1, 2, 4
+ * and 8 producer threads publishing concurrently while the main thread
+ * processes the bus. Producers retry an event dropped on a full queue, so
+ * every run delivers the same number of events.
+ *
+ * Build with SAFECORE_MPSC_ENABLED set to 1 in safecore_config.h:
+ *   gcc -std=c11 -O2 -I. tests/bench_mpsc.c safecore_*.c -lpthread -o bench_mpsc
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "safecore_core.h"
+#include "safecore_port.h"
+#include "safecore_config.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+#if SAFECORE_MPSC_ENABLED != 1
+    #error "The MPSC benchmark needs SAFECORE_MPSC_ENABLED set to 1"
+#endif
+
+/* === Benchmark Configuration === */
+#define BENCH_MAX_PRODUCERS     8U
+#define BENCH_EVENTS            1000000U /* Events per run, split over the producers */
+#define BENCH_QUEUE_SIZE        256U
+#define BENCH_EVENT_ID          1U
+
+/**
+ * @brief Benchmark event
+ */
+typedef struct {
+    sc_event_t header;
+    uint32_t value;
+} bench_event_t;
+
+SC_STATIC_ASSERT(sizeof(bench_event_t) <= SAFECORE_MAX_EVENT_SIZE,
+                 bench_event_must_fit_event_size);
+
+/* === Global Variables === */
+static sc_bus_t g_bus;
+static uint64_t g_bus_mem[SC_BUS_STORAGE_SIZE(1U, BENCH_QUEUE_SIZE, SAFECORE_MAX_EVENT_SIZE,
+                                              SAFECORE_TOTAL_QUEUES, SAFECORE_MAX_FILTER_RULES) / 8U + 1U];
+static uint32_t g_delivered;
+static uint32_t g_per_producer;
+static uint32_t g_retries[BENCH_MAX_PRODUCERS];
+
+/* === Platform Interface Implementation === */
+
+/**
+ * @brief Get current time in nanoseconds
+ *
+ * @return uint64_t Monotonic time in nanoseconds
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Get current system tick in milliseconds
+ *
+ * @return uint32_t Monotonic time in milliseconds
+ */
+uint32_t safecore_get_tick_ms(void) {
+    return (uint32_t)(bench_now_ns() / 1000000U);
+}
+
+/**
+ * @brief Get current system tick in microseconds
+ *
+ * @return uint32_t Monotonic time in microseconds
+ */
+uint32_t safecore_get_tick_us(void) {
+    return (uint32_t)(bench_now_ns() / 1000U);
+}
+
+/**
+ * @brief Error handler for SafeCore operations
+ *
+ * @param msg Error message to log
+ */
+void safecore_error_handler(const char *msg) {
+    (void)printf("ERROR: %s\n", msg);
+}
+
+/* === Benchmark Implementation === */
+
+/**
+ * @brief Count one delivered event
+ *
+ * @param e Delivered event
+ * @param ctx Unused
+ */
+static void bench_on_event(const sc_event_t *e, void *ctx) {
+    (void)e;
+    (void)ctx;
+    g_delivered++;
+}
+
+/**
+ * @brief Producer thread: publish its share of the run's events
+ *
+ * @param arg Producer index
+ * @return void* NULL
+ */
+static void *bench_producer(void *arg) {
+    uint32_t producer = (uint32_t)(uintptr_t)arg;
+    bench_event_t evt = {0};
+    uint32_t n;
+
+    evt.header.id = BENCH_EVENT_ID;
+    evt.header.size = (uint8_t)sizeof(evt);
+#if SAFECORE_PRIORITY_ENABLED == 1
+    evt.header.priority = (uint8_t)(producer % SAFECORE_TOTAL_QUEUES);
+#endif
+
+    for (n = 0U; n < g_per_producer; n++) {
+        evt.value = n;
+        while (sc_bus_publish_raw(&g_bus, (const uint8_t *)&evt, sizeof(evt)) != 0) {
+            g_retries[producer]++;
+            (void)sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run the benchmark with a number of producers
+ *
+ * @param producers Number of producer threads
+ * @return int 0 on success, -1 on failure
+ */
+static int bench_run(uint32_t producers) {
+    pthread_t threads[BENCH_MAX_PRODUCERS];
+    sc_bus_config_t cfg = { .max_subscribers = 1U, .queue_size = BENCH_QUEUE_SIZE,
+                            .max_event_size = SAFECORE_MAX_EVENT_SIZE,
+                            .priorities = SAFECORE_TOTAL_QUEUES,
+                            .max_filter_rules = SAFECORE_MAX_FILTER_RULES };
+    uint32_t retries = 0U;
+    uint32_t i;
+
+    if ((sc_bus_init(&g_bus, &cfg, g_bus_mem, sizeof(g_bus_mem)) != 0) ||
+        (sc_bus_subscribe(&g_bus, BENCH_EVENT_ID, bench_on_event, NULL) != 0)) {
+        return -1;
+    }
+
+    g_delivered = 0U;
+    g_per_producer = BENCH_EVENTS / producers;
+    uint32_t total = g_per_producer * producers;
+
+    uint64_t start = bench_now_ns();
+    for (i = 0U; i < producers; i++) {
+        g_retries[i] = 0U;
+        if (pthread_create(&threads[i], NULL, bench_producer, (void *)(uintptr_t)i) != 0) {
+            return -1;
+        }
+    }
+
+    while (g_delivered < total) {
+        uint32_t before = g_delivered;
+        sc_bus_process(&g_bus);
+        if (g_delivered == before) {
+            (void)sched_yield();
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    for (i = 0U; i < producers; i++) {
+        (void)pthread_join(threads[i], NULL);
+        retries += g_retries[i];
+    }
+
+    (void)printf("%9u %12u %12.1f %14.0f %12u\n", (unsigned)producers, (unsigned)total,
+                 (double)elapsed / 1e6, (double)total * 1e9 / (double)elapsed, (unsigned)retries);
+    return 0;
+}
+
+int main(void) {
+    uint32_t producers;
+
+    (void)printf("%9s %12s %12s %14s %12s\n", "producers", "events", "ms", "events/s", "retries");
+    for (producers = 1U; producers <= BENCH_MAX_PRODUCERS; producers *= 2U) {
+        if (bench_run(producers) != 0) {
+            (void)printf("FAIL: bus setup\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}